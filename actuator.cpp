@@ -0,0 +1,55 @@
+#include <Arduino.h>
+#include <string.h>
+#include "actuator.h"
+#include "motor.h"
+
+const char* const ACTUATOR_NAMES[ACT_COUNT] = {
+  "cup", "ramen_up", "ramen_ej", "powder", "outlet", "cooker"
+};
+
+int actuatorFind(const char* name) {
+  for (uint8_t a = 0; a < ACT_COUNT; a++) {
+    if (strcmp(name, ACTUATOR_NAMES[a]) == 0) return a;
+  }
+  return -1;
+}
+
+uint8_t actuatorOutputs(uint8_t act, uint8_t unit, uint8_t out[2]) {
+  switch (act) {
+    case ACT_CUP:      out[0] = CUP_MOTOR_OUT[unit]; return 1;
+    case ACT_RAMEN_UP: out[0] = RAMEN_UP_FWD_OUT[unit]; out[1] = RAMEN_UP_REV_OUT[unit]; return 2;
+    case ACT_RAMEN_EJ: out[0] = RAMEN_EJ_FWD_OUT[unit]; out[1] = RAMEN_EJ_REV_OUT[unit]; return 2;
+    case ACT_POWDER:   out[0] = POWDER_MOTOR_OUT[unit]; return 1;
+    case ACT_OUTLET:   out[0] = OUTLET_FWD_OUT[unit]; out[1] = OUTLET_REV_OUT[unit]; return 2;
+    case ACT_COOKER:
+      if (!COOKER_HAS_OUTPUT[unit]) return 0;
+      out[0] = COOKER_IND_SIG[unit]; out[1] = COOKER_WTR_SIG[unit]; return 2;
+    default:           return 0;
+  }
+}
+
+uint8_t actuatorCurrentPin(uint8_t act, uint8_t unit) {
+  switch (act) {
+    case ACT_CUP:      return CUP_CURR_AIN[unit];
+    case ACT_RAMEN_UP: return RAMEN_UP_CURR_AIN[unit];
+    case ACT_RAMEN_EJ: return RAMEN_EJ_CURR_AIN[unit];
+    case ACT_POWDER:   return POWDER_CURR_AIN[unit];
+    case ACT_OUTLET:   return OUTLET_CURR_AIN[unit];
+    default:           return COOKER_CURR_AIN[unit];
+  }
+}
+
+bool actuatorOn(uint8_t act, uint8_t unit) {
+  uint8_t out[2];
+  uint8_t n = actuatorOutputs(act, unit, out);
+  for (uint8_t k = 0; k < n; k++) {
+    if (motorOn(out[k])) return true;
+  }
+  return false;
+}
+
+void actuatorCut(uint8_t act, uint8_t unit) {
+  uint8_t out[2];
+  uint8_t n = actuatorOutputs(act, unit, out);
+  for (uint8_t k = 0; k < n; k++) motorStop(out[k]);
+}
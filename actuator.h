@@ -0,0 +1,44 @@
+#ifndef ACTUATOR_H
+#define ACTUATOR_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// =======================================================
+// === 액추에이터 식별자 / 출력 핀 매핑
+// === 과전류 보호(protect)와 동작 감시(supervisor)가 같은 표를 쓴다.
+// =======================================================
+
+enum ActuatorId : uint8_t {
+  ACT_CUP = 0,      // CUP_MOTOR_OUT
+  ACT_RAMEN_UP,     // RAMEN_UP_FWD/REV_OUT (리프트)
+  ACT_RAMEN_EJ,     // RAMEN_EJ_FWD/REV_OUT (배출)
+  ACT_POWDER,       // POWDER_MOTOR_OUT
+  ACT_OUTLET,       // OUTLET_FWD/REV_OUT
+  ACT_COOKER,       // COOKER_IND/WTR_SIG (COOKER_HAS_OUTPUT 인 장비만)
+  ACT_COUNT
+};
+
+const uint8_t ACTUATOR_MAX_UNITS = 8;   // powder 최대 8
+
+extern const char* const ACTUATOR_NAMES[ACT_COUNT];
+
+/** @brief 이름 -> ActuatorId (없으면 -1) */
+int actuatorFind(const char* name);
+
+/**
+ * @brief 액추에이터 출력 핀
+ * @return 핀 수 (0~2)
+ */
+uint8_t actuatorOutputs(uint8_t act, uint8_t unit, uint8_t out[2]);
+
+/** @brief 전류 감지 아날로그 핀 */
+uint8_t actuatorCurrentPin(uint8_t act, uint8_t unit);
+
+/** @brief 출력 중 하나라도 구동 중인지 (PWM 램프 포함) */
+bool actuatorOn(uint8_t act, uint8_t unit);
+
+/** @brief 모든 출력 LOW (인터럽트 컨텍스트에서도 사용 가능) */
+void actuatorCut(uint8_t act, uint8_t unit);
+
+#endif // ACTUATOR_H
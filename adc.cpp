@@ -0,0 +1,164 @@
+#include <Arduino.h>
+#include "adc.h"
+
+// =======================================================
+// === 채널 상태 (인덱스 = 핀 - A0)
+// =======================================================
+
+const uint8_t ADC_CHANNELS = 12;   // A0 ~ A11
+
+struct AdcChannel {
+  uint32_t acc;               // 오버샘플 누적 (12bit 샘플)
+  uint8_t n;                  // 누적 개수
+  uint8_t shift;              // AdcFilter
+  int32_t filtQ8;             // IIR 상태 (10bit, Q8)
+  volatile uint16_t raw;      // 데시메이션 값
+  volatile uint16_t value;    // 필터 출력
+};
+
+static AdcChannel channels[ADC_CHANNELS];
+static volatile uint32_t updates = 0;
+
+// log2(ADC_OVERSAMPLE) + 2 : 합계 -> 10bit
+static uint8_t decimateShift() {
+  uint8_t s = 2;
+  for (uint16_t n = ADC_OVERSAMPLE; n > 1; n >>= 1) s++;
+  return s;
+}
+static const uint8_t DECIMATE_SHIFT = decimateShift();
+
+static inline int channelIndex(uint8_t pin) {
+  return (pin >= A0 && pin < A0 + ADC_CHANNELS) ? pin - A0 : -1;
+}
+
+// 12bit 샘플 1개 누적. ADC_OVERSAMPLE 개가 모이면 데시메이션 + IIR
+static inline void accumulate(AdcChannel& c, uint16_t sample12) {
+  c.acc += sample12;
+  if (++c.n < ADC_OVERSAMPLE) return;
+
+  uint16_t dec = (uint16_t)(c.acc >> DECIMATE_SHIFT);
+  c.acc = 0;
+  c.n = 0;
+  c.raw = dec;
+  if (c.filtQ8 < 0) c.filtQ8 = (int32_t)dec << 8;     // 첫 값으로 초기화 (기동 과도 제거)
+  c.filtQ8 += (((int32_t)dec << 8) - c.filtQ8) >> c.shift;
+  c.value = (uint16_t)((c.filtQ8 + 128) >> 8);
+}
+
+int adcRead(uint8_t pin) {
+  int i = channelIndex(pin);
+  return i < 0 ? 0 : channels[i].value;
+}
+
+int adcReadRaw(uint8_t pin) {
+  int i = channelIndex(pin);
+  return i < 0 ? 0 : channels[i].raw;
+}
+
+void adcSetFilter(uint8_t pin, AdcFilter filter) {
+  int i = channelIndex(pin);
+  if (i >= 0) channels[i].shift = filter;
+}
+
+uint32_t adcUpdates() {
+  return updates;
+}
+
+static void resetChannels() {
+  for (uint8_t i = 0; i < ADC_CHANNELS; i++) {
+    AdcChannel& c = channels[i];
+    c.acc = 0;
+    c.n = 0;
+    c.shift = ADC_FILTER_FAST;
+    c.filtQ8 = -1;
+    c.raw = 0;
+    c.value = 0;
+  }
+}
+
+#ifdef ARDUINO_ARCH_SAM
+// =======================================================
+// === SAM3X: free-running 스캔 + PDC 이중 버퍼
+// === - 스캔 순서는 하드웨어 채널 번호 오름차순이므로 ADC_EMR_TAG 로
+// ===   결과마다 채널 번호(bit 12~15)를 받아 역매핑한다.
+// === - 버퍼 1개 = 모든 채널 x ADC_OVERSAMPLE 스캔. ENDRX 시 PDC 는 이미
+// ===   다음 버퍼로 넘어가 있으므로, 끝난 버퍼를 처리한 뒤 next 로 재등록.
+// =======================================================
+
+static const uint16_t DMA_LEN = ADC_CHANNELS * ADC_OVERSAMPLE;
+static uint16_t dmaBuf[2][DMA_LEN];
+static uint8_t dmaDone = 0;              // 다음에 완료될 버퍼
+static int8_t hwToIndex[16];
+
+void adcBegin() {
+  resetChannels();
+
+  uint32_t mask = 0;
+  for (uint8_t i = 0; i < 16; i++) hwToIndex[i] = -1;
+  for (uint8_t i = 0; i < ADC_CHANNELS; i++) {
+    uint32_t hw = g_APinDescription[A0 + i].ulADCChannelNumber;
+    hwToIndex[hw] = (int8_t)i;
+    mask |= 1u << hw;
+  }
+
+  pmc_enable_periph_clk(ID_ADC);
+  ADC->ADC_CR = ADC_CR_SWRST;
+  // ADC 클럭 = MCK / (2 x (PRESCAL+1)) = 1MHz, 채널당 약 20us -> 스캔 약 4kHz
+  ADC->ADC_MR = ADC_MR_FREERUN_ON | ADC_MR_PRESCAL(41) | ADC_MR_STARTUP_SUT64 |
+                ADC_MR_SETTLING_AST3 | ADC_MR_TRACKTIM(15) | ADC_MR_TRANSFER(1);
+  ADC->ADC_EMR = ADC_EMR_TAG;
+  ADC->ADC_CHDR = ~mask;
+  ADC->ADC_CHER = mask;
+
+  ADC->ADC_PTCR = ADC_PTCR_RXTDIS;
+  ADC->ADC_RPR = (uint32_t)dmaBuf[0];
+  ADC->ADC_RCR = DMA_LEN;
+  ADC->ADC_RNPR = (uint32_t)dmaBuf[1];
+  ADC->ADC_RNCR = DMA_LEN;
+  dmaDone = 0;
+  ADC->ADC_IDR = ~0u;
+  ADC->ADC_IER = ADC_IER_ENDRX;
+  NVIC_SetPriority(ADC_IRQn, 10);   // 엔코더(PIO), tick(TC3) 보다 낮게
+  NVIC_EnableIRQ(ADC_IRQn);
+  ADC->ADC_PTCR = ADC_PTCR_RXTEN;
+  ADC->ADC_CR = ADC_CR_START;
+}
+
+void ADC_Handler() {
+  if ((ADC->ADC_ISR & ADC_ISR_ENDRX) == 0) return;
+  const uint16_t* buf = dmaBuf[dmaDone];
+  for (uint16_t k = 0; k < DMA_LEN; k++) {
+    int8_t i = hwToIndex[buf[k] >> 12];
+    if (i >= 0) accumulate(channels[i], buf[k] & 0x0FFF);
+  }
+  ADC->ADC_RNPR = (uint32_t)dmaBuf[dmaDone];
+  ADC->ADC_RNCR = DMA_LEN;
+  dmaDone ^= 1;
+  updates = updates + 1;   // 버퍼 1개 = 채널마다 데시메이션 1회
+}
+
+void adcPoll() {
+}
+
+#else
+// =======================================================
+// === 그 외: analogRead 로 스캔을 흉내 (호스트 시뮬레이터의 파형 재생 포함)
+// =======================================================
+
+static uint32_t lastScanUs = 0;
+
+void adcBegin() {
+  resetChannels();
+  lastScanUs = micros();
+}
+
+void adcPoll() {
+  uint32_t now = micros();
+  if (now - lastScanUs < ADC_SCAN_US) return;
+  lastScanUs = now;
+  for (uint8_t i = 0; i < ADC_CHANNELS; i++) {
+    accumulate(channels[i], (uint16_t)(analogRead(A0 + i) << 2));   // 10bit -> 12bit
+  }
+  if (channels[0].n == 0) updates = updates + 1;
+}
+#endif
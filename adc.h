@@ -0,0 +1,44 @@
+#ifndef ADC_H
+#define ADC_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// =======================================================
+// === ADC 수집 엔진 (A0~A11 전체 채널 상시 변환)
+// === - SAM: ADC free-running 다채널 스캔 + PDC(DMA) 이중 버퍼,
+// ===   버퍼가 찰 때마다(ENDRX) 인터럽트에서 채널별 필터 적용
+// === - 그 외(호스트): adcPoll() 이 ADC_SCAN_US 마다 analogRead 로 한 스캔 수행
+// === - 필터: ADC_OVERSAMPLE 개 평균(데시메이션, 12bit -> 10bit) 후
+// ===   채널별 1차 IIR (shift 가 클수록 느리고 매끈함)
+// === - loop() 는 adcRead() 로 필터된 10bit 값을 변환 대기 없이 읽는다.
+// ===   (엔진 시작 후에는 analogRead() 를 직접 부르지 말 것: ADC 설정이 바뀜)
+// =======================================================
+
+// 채널별 IIR 필터 세기 (adcSetFilter)
+enum AdcFilter : uint8_t {
+  ADC_FILTER_NONE   = 0,   // 데시메이션 값 그대로
+  ADC_FILTER_FAST   = 1,   // 모터 전류 (과전류 감시용, 지연 최소)
+  ADC_FILTER_MEDIUM = 3,   // 초음파 거리
+  ADC_FILTER_SLOW   = 5    // 로드셀
+};
+
+/** @brief 엔진 시작 (setup 에서 1회) */
+void adcBegin();
+
+/** @brief 비 SAM 빌드에서 스캔 수행 (loop 에서 매번 호출, SAM 에서는 할 일 없음) */
+void adcPoll();
+
+/** @brief 필터된 값 (10bit, A0~A11 이외의 핀은 0) */
+int adcRead(uint8_t pin);
+
+/** @brief IIR 전 데시메이션 값 (10bit) */
+int adcReadRaw(uint8_t pin);
+
+/** @brief 채널 필터 지정 (장비 setup 시 배선 용도에 맞게) */
+void adcSetFilter(uint8_t pin, AdcFilter filter);
+
+/** @brief 데시메이션 완료 횟수 (채널당 출력 갱신 수, 통계용) */
+uint32_t adcUpdates();
+
+#endif // ADC_H
@@ -0,0 +1,138 @@
+#include <Arduino.h>
+#include "binproto.h"
+#include "config.h"
+#include "state.h"
+#include "protocol.h"
+#include "txbuffer.h"
+#include "dispatch.h"
+#include "reporting.h"
+
+static_assert(sizeof(StatePacket) <= BIN_MAX_PAYLOAD, "StatePacket too large for one frame");
+
+// 니블 단위 CRC16-CCITT 테이블 (32바이트)
+static const uint16_t CRC16_NIBBLE[16] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+uint16_t binCrc16(const uint8_t* data, uint16_t len, uint16_t crc) {
+  while (len--) {
+    crc = (uint16_t)((crc << 4) ^ CRC16_NIBBLE[((crc >> 12) ^ (*data >> 4)) & 0x0F]);
+    crc = (uint16_t)((crc << 4) ^ CRC16_NIBBLE[((crc >> 12) ^ (*data & 0x0F)) & 0x0F]);
+    data++;
+  }
+  return crc;
+}
+
+static uint16_t readU16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+/**
+ * @brief 프레임 하나를 조립해 송신 채널에 원자적으로 기록
+ * @return 채널 공간 부족으로 버려지면 false
+ */
+bool binSendFrame(TxChannel& out, uint8_t op, const uint8_t* payload, uint8_t len) {
+  uint8_t frame[BIN_MAX_PAYLOAD + BIN_OVERHEAD];
+  if (len > BIN_MAX_PAYLOAD) return false;
+  frame[0] = BIN_SYNC;
+  frame[1] = len;
+  frame[2] = op;
+  memcpy(&frame[3], payload, len);
+  uint16_t crc = binCrc16(&frame[1], (uint16_t)(len + 2));
+  frame[3 + len] = (uint8_t)(crc & 0xFF);
+  frame[4 + len] = (uint8_t)(crc >> 8);
+
+  return out.writeRecord(frame, (uint16_t)(len + BIN_OVERHEAD));
+}
+
+void binReplyStatus(uint8_t op, uint8_t status) {
+  uint8_t p[2] = { op, status };
+  binSendFrame(TxEvent, BIN_OP_ACK, p, sizeof(p));
+}
+
+// =======================================================
+// === 명령 실행 (JSON 경로와 같은 명령 테이블 사용)
+// =======================================================
+
+static uint8_t binExecute(uint8_t op, const uint8_t* p, uint8_t len) {
+  const CommandSpec* cmd = findCommandByOp(op);
+  if (cmd == nullptr) return CMD_ERR_OPCODE;
+  if (len < 1) return CMD_ERR_LENGTH;
+
+  CommandArgs args;
+  uint8_t off = 1;
+  for (uint8_t a = 0; a < ARG_COUNT; a++) {
+    args.v[a] = 0;
+    if (!(cmd->args & ARG_BIT(a))) continue;
+    if (off + 2 > len) return CMD_ERR_LENGTH;
+    args.v[a] = readU16(&p[off]);
+    off += 2;
+  }
+  return executeCommand(cmd, p[0], args);
+}
+
+void binDispatch(uint8_t op, const uint8_t* payload, uint8_t len) {
+  binReplyStatus(op, binExecute(op, payload, len));
+}
+
+// =======================================================
+// === 상태 스냅샷 송신 (publishStateJson 의 바이너리 버전)
+// =======================================================
+
+static uint8_t packBits(const int* v, uint8_t n) {
+  uint8_t bits = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    if (v[i]) bits |= (uint8_t)(1 << i);
+  }
+  return bits;
+}
+
+void publishStateBinary() {
+  const State& state = stateSnapshot();
+  StatePacket pkt;
+  memset(&pkt, 0, sizeof(pkt));
+  uint8_t i;
+
+  pkt.version = STATE_PACKET_VERSION;
+  pkt.cup = current.cup;
+  pkt.ramen = current.ramen;
+  pkt.powder = current.powder;
+  pkt.cooker = current.cooker;
+  pkt.outlet = current.outlet;
+  pkt.door = (uint8_t)((state.door_sensor1 ? 1 : 0) | (state.door_sensor2 ? 2 : 0));
+
+  for (i = 0; i < MAX_CUP; i++) pkt.cup_amp[i] = (uint16_t)state.cup_amp[i];
+  pkt.cup_stock = packBits(state.cup_stock, MAX_CUP);
+  pkt.cup_dispense = packBits(state.cup_dispense, MAX_CUP);
+
+  for (i = 0; i < MAX_RAMEN; i++) {
+    pkt.ramen_amp[i] = (uint16_t)state.ramen_amp[i];
+    pkt.ramen_lift[i] = state.ramen_lift[i];
+    pkt.ramen_loadcell[i] = (int16_t)state.ramen_loadcell[i];
+    pkt.ramen_velocity[i] = (int16_t)constrain(state.ramen_velocity[i], -32768, 32767);
+  }
+  pkt.ramen_stock = packBits(state.ramen_stock, MAX_RAMEN);
+
+  for (i = 0; i < MAX_POWDER; i++) pkt.powder_amp[i] = (uint16_t)state.powder_amp[i];
+  pkt.powder_dispense = packBits(state.powder_dispense, MAX_POWDER);
+
+  for (i = 0; i < MAX_COOKER; i++) {
+    pkt.cooker_amp[i] = (uint16_t)state.cooker_amp[i];
+    pkt.cooker_work[i] = (uint8_t)state.cooker_work[i];
+    pkt.cooker_remain[i] = (uint16_t)state.cooker_remain[i];
+  }
+
+  for (i = 0; i < MAX_OUTLET; i++) {
+    pkt.outlet_amp[i] = (uint16_t)state.outlet_amp[i];
+    pkt.outlet_sonar[i] = (int16_t)state.outlet_sonar[i];
+    pkt.outlet_loadcell[i] = (int16_t)state.outlet_loadcell[i];
+  }
+  pkt.outlet_door = packBits(state.outlet_door, MAX_OUTLET);
+
+  pkt.epoch = state.epoch;
+  pkt.frame = nextTelemetryFrame();
+  pkt.pass_us = state.pass_us;
+
+  binSendFrame(TxTelemetry, BIN_OP_STATE, (const uint8_t*)&pkt, sizeof(pkt));
+}
@@ -0,0 +1,80 @@
+#ifndef BINPROTO_H
+#define BINPROTO_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "txbuffer.h"
+
+// =======================================================
+// === 바이너리 프레임 프로토콜 (setting "protocol":"binary" 로 활성화)
+// ===
+// ===  | SYNC 0xA5 | LEN | OP | PAYLOAD (LEN 바이트) | CRC16 (LE) |
+// ===
+// ===  - CRC16-CCITT (poly 0x1021, init 0xFFFF), LEN/OP/PAYLOAD 대상
+// ===  - 다중 바이트 값은 모두 little-endian
+// ===  - 텍스트 줄은 0xA5 로 시작할 수 없으므로(ASCII/UTF-8 선두 바이트)
+// ===    같은 선로에서 JSON/로그 줄과 바이너리 프레임이 섞여도 구분된다
+// =======================================================
+
+const uint8_t BIN_SYNC        = 0xA5;
+const uint8_t BIN_OVERHEAD    = 5;     // SYNC + LEN + OP + CRC16
+const uint8_t BIN_MAX_PAYLOAD = 250;
+
+// ----- 호스트 -> 장비 명령 (PAYLOAD[0] = control, 1부터) -----
+// 이후 인자는 명령 테이블(dispatch.cpp)의 스키마 순서대로 u16
+enum BinOpcode : uint8_t {
+  BIN_OP_CUP_STARTDISPENSE    = 0x10,
+  BIN_OP_CUP_STOPDISPENSE     = 0x11,
+  BIN_OP_RAMEN_STARTDISPENSE  = 0x20,
+  BIN_OP_RAMEN_READYDISPENSE  = 0x21,
+  BIN_OP_RAMEN_INITDISPENSE   = 0x22,
+  BIN_OP_RAMEN_STOPDISPENSE   = 0x23,
+  BIN_OP_POWDER_STARTDISPENSE = 0x30,  // + time u16 (x100ms)
+  BIN_OP_POWDER_STOPDISPENSE  = 0x31,
+  BIN_OP_COOKER_STARTCOOK     = 0x40,  // + water u16, timer u16
+  BIN_OP_COOKER_STOPCOOK      = 0x41,
+  BIN_OP_OUTLET_OPENDOOR      = 0x50,
+  BIN_OP_OUTLET_CLOSEDOOR     = 0x51,
+  BIN_OP_OUTLET_STOPOUTLET    = 0x52,
+
+  // ----- 장비 -> 호스트 -----
+  BIN_OP_ACK   = 0x80,   // payload: 요청 OP, 상태(CommandStatus)
+  BIN_OP_STATE = 0x81    // payload: StatePacket
+};
+
+// 주기 보고용 상태 스냅샷 (JSON 텔레메트리의 모든 필드)
+const uint8_t STATE_PACKET_VERSION = 5;   // v2: ramen_velocity, v3: cooker_remain 추가, v4: loadcell/sonar 교정값, v5: epoch/frame/시각
+
+struct __attribute__((packed)) StatePacket {
+  uint8_t version;
+  uint8_t cup, ramen, powder, cooker, outlet;   // 설정된 장비 수
+  uint8_t door;                                 // bit0 sensor1, bit1 sensor2
+  uint16_t cup_amp[MAX_CUP];
+  uint8_t cup_stock;                            // bit i = 장비 i
+  uint8_t cup_dispense;
+  uint16_t ramen_amp[MAX_RAMEN];
+  uint8_t ramen_stock;
+  int32_t ramen_lift[MAX_RAMEN];
+  int16_t ramen_loadcell[MAX_RAMEN];           // g (v4)
+  uint16_t powder_amp[MAX_POWDER];
+  uint8_t powder_dispense;
+  uint16_t cooker_amp[MAX_COOKER];
+  uint8_t cooker_work[MAX_COOKER];
+  uint16_t outlet_amp[MAX_OUTLET];
+  uint8_t outlet_door;
+  int16_t outlet_sonar[MAX_OUTLET];             // mm (v4)
+  int16_t outlet_loadcell[MAX_OUTLET];          // g (v4)
+  int16_t ramen_velocity[MAX_RAMEN];            // count/s (v2)
+  uint16_t cooker_remain[MAX_COOKER];           // 초 (v3)
+  uint32_t epoch;                               // 스냅샷 번호 (v5, reporting.h)
+  uint32_t frame;                               // 텔레메트리 레코드 번호 (v5, 빈 번호 = 드롭)
+  uint32_t pass_us;                             // 이 회차 읽기 시작 시각 micros (v5)
+};
+
+uint16_t binCrc16(const uint8_t* data, uint16_t len, uint16_t crc = 0xFFFF);
+bool binSendFrame(TxChannel& out, uint8_t op, const uint8_t* payload, uint8_t len);
+void binDispatch(uint8_t op, const uint8_t* payload, uint8_t len);
+void binReplyStatus(uint8_t op, uint8_t status);
+void publishStateBinary();
+
+#endif // BINPROTO_H
@@ -10,6 +10,12 @@ const uint8_t MAX_POWDER  = 8;
 const uint8_t MAX_COOKER  = 4;
 const uint8_t MAX_OUTLET  = 4;
 
+// ===== 타이머 예약 =====
+// TC3 (TC1 채널0) 은 고정 주기 tick(tick.h) 전용. 헤더 핀이 없는 채널이라
+// 아래 핀맵의 analogWrite() 와 충돌하지 않는다.
+// analogWrite() 는 D6~D9 는 PWM, D2~D5/D10~D13 은 TC0/TC6/TC7/TC8 채널을 재설정하므로
+// 이 채널들을 다른 용도로 쓰지 말 것.
+
 // ===== 1. cup 핀맵 =====
 const uint8_t CUP_MOTOR_OUT[4]   = {4, 8, 12, 24};
 const uint8_t CUP_ROT_IN[4]      = {5, 9, 13, 25};
@@ -34,7 +40,13 @@ const uint8_t RAMEN_PRESENT_IN[4] = {12, 29, 38, 47};
 const uint8_t RAMEN_UP_CURR_AIN[4]  = {A0, A2, A4, A6}; // 모터 전류 센서
 const uint8_t RAMEN_EJ_CURR_AIN[4]  = {A1, A3, A5, A7}; // 리니어 엑추에이터 전류 센서
 
-const uint8_t RAMEN_ENCORDER[8] = {2, 3, 16, 17, 18, 19, 20, 21};
+const uint8_t RAMEN_ENCORDER[8] = {2, 3, 16, 17, 18, 19, 20, 21}; // 장비별 A, B 순
+const int ENCODER_CPR = 400;  // 100 PPR x4 (A/B 양 에지)
+const int32_t RAMEN_RISE_TRAVEL_MAX[4] = {3000, 3000, 3000, 3000}; // 1회 상승 최대 이동 (count)
+const uint8_t ENCODER_VEL_FILTER_SHIFT = 3;   // 속도 IIR 필터 (1/8)
+const int32_t RAMEN_STALL_MIN_CPS = 150;      // 구동 중 이 속도(count/s) 미만이면 저속
+const uint16_t RAMEN_STALL_GRACE_TICKS = 200; // 기동 후 감시 유예 (tick)
+const uint16_t RAMEN_STALL_TICKS = 40;        // 연속 저속 tick 수 -> 정체로 판단
 
 // ===== 3. powder 핀맵 =====
 const uint8_t POWDER_MOTOR_OUT[8] = {4,5,6,7,8,9,10,11};
@@ -61,4 +73,105 @@ const uint8_t DOOR_SENSOR2_PIN = 15;
 // ===== 7. 동작 파라미터 =====
 const unsigned long PUBLISH_INTERVAL_MS = 500; // 0.1초
 
+// ===== 8. 루프 프로파일러 =====
+// 1: loop() 단계별 소요 시간(us)을 히스토그램으로 누적 ({"device":"stats"} 로 조회)
+// 0: 계측 코드가 컴파일되지 않음
+#ifndef LOOP_PROFILER
+#define LOOP_PROFILER 1
+#endif
+
+// ===== 9. 시리얼 송신 버퍼 (2의 거듭제곱) =====
+const uint16_t TX_EVENT_BUFFER_SIZE     = 2048;  // 응답/완료 이벤트
+const uint16_t TX_TELEMETRY_BUFFER_SIZE = 4096;  // 주기 텔레메트리
+
+// ===== 10. 명령 수신 프레임 =====
+const uint16_t RX_FRAME_MAX = 512;  // 한 줄(JSON 명령) 최대 길이
+const uint16_t RX_CHUNK     = 128;  // loop() 1회에 읽는 최대 바이트
+const unsigned long RX_BINARY_TIMEOUT_MS = 50;  // 바이너리 프레임 바이트 간 최대 간격
+
+// ===== 11. 변경 기반 텔레메트리 (telemetry.h) =====
+const unsigned long TELEMETRY_SAMPLE_MS   = 10;    // 센서 샘플링/에지 감시 주기
+const unsigned long TELEMETRY_KEYFRAME_MS = 5000;  // 전체 상태 재전송 주기
+const uint16_t TELEMETRY_AMP_DEADBAND      = 8;    // ADC count
+const uint16_t TELEMETRY_SONAR_DEADBAND    = 5;    // mm (measure.h 교정값)
+const uint16_t TELEMETRY_LOADCELL_DEADBAND = 5;    // g
+const uint16_t TELEMETRY_LIFT_DEADBAND     = 2;    // 엔코더 count
+const uint16_t TELEMETRY_VELOCITY_DEADBAND = 40;   // count/s
+const uint8_t  TELEMETRY_MAX_SUBS   = 8;       // 구독 수 ({"device":"subscribe"})
+const uint16_t TELEMETRY_SUB_MIN_MS = 10;      // 구독 주기 하한 (= 샘플 주기)
+
+// ===== 12. ADC 수집 엔진 (adc.h) =====
+const uint8_t ADC_OVERSAMPLE = 16;        // 데시메이션 1회당 채널별 샘플 수 (2의 거듭제곱)
+const unsigned long ADC_SCAN_US = 250;    // 비 SAM 빌드의 스캔 주기 (SAM 하드웨어 스캔 속도와 비슷하게)
+
+// ===== 13. 고정 주기 tick (tick.h) =====
+const uint16_t FAST_TICK_HZ = 1000;   // 엔코더 속도/정체, 과전류 보호 평가 주기
+
+// ===== 14. 과전류 보호 기본값 (protect.h, ADC count 10bit / ms) =====
+const uint16_t PROTECT_TRIP_AMP    = 900;       // 이 값을 넘으면 즉시 차단 (블랭킹 후)
+const uint16_t PROTECT_NOMINAL_AMP = 500;       // 이 값을 넘는 만큼 I²t 누적
+const uint32_t PROTECT_I2T_LIMIT   = 10000000;  // (count 초과분)² x ms
+const uint32_t PROTECT_I2T_LIMIT_MAX = 1000000000;  // set 상한 (누적값은 UINT32_MAX 에서 포화)
+const uint16_t PROTECT_BLANK_MS    = 60;        // 기동 돌입전류 무시 구간
+const uint16_t PROTECT_COOKER_TRIP_AMP    = 1000;  // 쿠커: 인덕션은 정상 가동 중 ~720 이 계속 흐름
+const uint16_t PROTECT_COOKER_NOMINAL_AMP = 950;
+
+// ===== 15. 동작 감시 / 워치독 (supervisor.h, ms) =====
+const uint16_t MOTION_CUP_EXPECTED_MS      = 1500;  // 용기 1회 배출
+const uint16_t MOTION_CUP_MAX_MS           = 4000;
+const uint16_t MOTION_RAMEN_UP_EXPECTED_MS = 3000;  // 리프트 상승/하강
+const uint16_t MOTION_RAMEN_UP_MAX_MS      = 8000;
+const uint16_t MOTION_RAMEN_EJ_EXPECTED_MS = 2000;  // 배출 전진/복귀 각 단계
+const uint16_t MOTION_RAMEN_EJ_MAX_MS      = 5000;
+const uint16_t MOTION_OUTLET_EXPECTED_MS   = 2000;  // 배출구 열기/닫기
+const uint16_t MOTION_OUTLET_MAX_MS        = 5000;
+const uint32_t WATCHDOG_TIMEOUT_MS = 500;   // loop 가 이 시간 동안 kick 못 하면 리셋
+const uint16_t WATCHDOG_CHECK_MS   = 50;    // 건강 검사/kick 주기
+
+// ===== 16. 모터 램프 프로파일 (motor.h, {"device":"motor"} 로 변경 가능) =====
+// shape: 0 = step(램프 없음), 1 = linear, 2 = S-curve. PWM 가능 핀(D2~D13)에만 적용
+const uint8_t  MOTOR_CUP_SHAPE            = 1;
+const uint16_t MOTOR_CUP_RAMP_MS          = 150;
+const uint8_t  MOTOR_CUP_MIN_DUTY         = 90;
+const uint8_t  MOTOR_RAMEN_UP_SHAPE       = 2;
+const uint16_t MOTOR_RAMEN_UP_RAMP_MS     = 250;
+const uint8_t  MOTOR_RAMEN_UP_MIN_DUTY    = 70;
+const uint8_t  MOTOR_RAMEN_UP_SLOW_DUTY   = 110;  // 상한/원점 접근 시 duty
+const uint16_t MOTOR_RAMEN_UP_SLOW_COUNTS = 300;  // 감속 구간 (count)
+const uint8_t  MOTOR_RAMEN_EJ_SHAPE       = 1;
+const uint16_t MOTOR_RAMEN_EJ_RAMP_MS     = 150;
+const uint8_t  MOTOR_RAMEN_EJ_MIN_DUTY    = 90;
+const uint8_t  MOTOR_OUTLET_SHAPE         = 2;
+const uint16_t MOTOR_OUTLET_RAMP_MS       = 300;
+const uint8_t  MOTOR_OUTLET_MIN_DUTY      = 70;
+
+// ===== 17. 쿠커 조리 시퀀스 (cooker.h) =====
+const bool COOKER_HAS_OUTPUT[4] = {true, true, false, false}; // 3, 4번은 출력 배선 없음 (시퀀스/보고만)
+const uint16_t COOKER_FILL_ML_PER_S  = 25;    // 급수 유량
+const uint16_t COOKER_HEAT_MS_PER_ML = 40;    // 끓을 때까지 예열 시간 (물 1ml 당)
+const uint16_t COOKER_WATER_MAX_ML   = 1500;
+const uint16_t COOKER_TIMER_MAX_S    = 1800;
+
+// ===== 18. 주문 레시피 큐 (recipe.h) =====
+const uint8_t  RECIPE_MAX_STEPS   = 32;      // 대기 + 실행 중 단계 합계 (여러 주문 공유)
+const uint16_t RECIPE_WAIT_MAX_MS = 60000;   // wait 단계 최대
+
+// ===== 19. 로드셀 / 초음파 측정 (measure.h) =====
+const uint8_t NO_AIN = 0xFF;                               // 배선 없음
+const uint8_t RAMEN_LOAD_AIN[4] = {NO_AIN, NO_AIN, NO_AIN, NO_AIN}; // 면 로드셀 (배선 확정 시 지정)
+const uint8_t MEAS_TICK_DIV    = 2;      // fastTick 2회에 1 샘플 (500Hz)
+const uint8_t MEAS_MEDIAN_N    = 5;      // 스파이크 제거 중앙값 창 (홀수, 최대 7)
+const uint8_t MEAS_LOAD_SHIFT  = 5;      // 로드셀 IIR (1/32, 약 64ms 시정수)
+const uint8_t MEAS_SONAR_SHIFT = 3;      // 초음파 IIR (1/8, 약 16ms)
+const int32_t MEAS_LOAD_FULL_G   = 5000; // 기본 교정: ADC 0 -> 0g, 1023 -> 이 값
+const int32_t MEAS_SONAR_FULL_MM = 3000; // 기본 교정: ADC 0 -> 0mm, 1023 -> 이 값
+const int32_t MEAS_BOWL_ON_G   = 150;    // 배출구 그릇 감지 (히스테리시스)
+const int32_t MEAS_BOWL_OFF_G  = 80;
+const uint16_t MEAS_BOWL_DEBOUNCE_MS = 200;
+
+// ===== 20. 이벤트 기록기 (evlog.h) =====
+const uint16_t EVLOG_SIZE     = 512;   // 기록 수 (2의 거듭제곱, 1개 8B -> 4KB RAM)
+const uint8_t  EVLOG_DUMP_MAX = 32;    // dump 명령 1회에 보내는 최대 기록 수
+const uint8_t  EVLOG_LINE_RECORDS = 16; // dump 한 줄(JSON)에 담는 기록 수
+
 #endif // CONFIG_H
\ No newline at end of file
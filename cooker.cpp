@@ -0,0 +1,131 @@
+#include <Arduino.h>
+#include "cooker.h"
+#include "actuator.h"
+#include "protect.h"
+#include "timerwheel.h"
+#include "txbuffer.h"
+#include "fastio.h"
+
+static const char* const PHASE_NAMES[] = { "idle", "fill", "heat", "hold", "done" };
+
+struct CookUnit {
+  Timer phaseTimer;            // 현재 단계 종료
+  uint8_t phase = COOK_IDLE;
+  unsigned long heatMs = 0;
+  unsigned long holdMs = 0;    // 0 = stopcook 까지
+};
+
+static CookUnit units[MAX_COOKER];
+
+static void setOutputs(uint8_t idx, uint8_t water, uint8_t induction) {
+  if (!COOKER_HAS_OUTPUT[idx]) return;
+  fioWrite(COOKER_WTR_SIG[idx], water);
+  fioWrite(COOKER_IND_SIG[idx], induction);
+}
+
+static void reportPhase(uint8_t idx) {
+  TxEvent.print("상태: 쿠커 "); TxEvent.print(PHASE_NAMES[units[idx].phase]);
+  TxEvent.print(" (장비: "); TxEvent.print(idx + 1); TxEvent.println(")");
+}
+
+static void advance(uint8_t idx);
+
+static void enterPhase(uint8_t idx, uint8_t phase, unsigned long ms) {
+  CookUnit& u = units[idx];
+  u.phase = phase;
+  switch (phase) {
+    case COOK_FILL: setOutputs(idx, HIGH, LOW); break;
+    case COOK_HEAT:
+    case COOK_HOLD: setOutputs(idx, LOW, HIGH); break;
+    default:        setOutputs(idx, LOW, LOW); break;
+  }
+  timerCancel(u.phaseTimer);
+  if (phase != COOK_DONE && phase != COOK_IDLE && !(phase == COOK_HOLD && ms == 0)) {
+    timerStart(u.phaseTimer, ms, advance, idx);
+  }
+  reportPhase(idx);
+}
+
+// 단계 종료 (타이머 휠 콜백). 길이 0 인 단계는 건너뜀
+static void advance(uint8_t idx) {
+  CookUnit& u = units[idx];
+  if (protectTripped(ACT_COOKER, idx)) {
+    cookerAbort(idx);
+    return;
+  }
+  switch (u.phase) {
+    case COOK_FILL:
+      if (u.heatMs > 0) { enterPhase(idx, COOK_HEAT, u.heatMs); break; }
+      // fallthrough
+    case COOK_HEAT:
+      enterPhase(idx, COOK_HOLD, u.holdMs);
+      break;
+    case COOK_HOLD:
+      enterPhase(idx, COOK_DONE, 0);
+      TxEvent.print("완료: 조리 완료 (장비: "); TxEvent.print(idx + 1); TxEvent.println(")");
+      break;
+    default: break;
+  }
+}
+
+bool cookerStart(uint8_t idx, int waterMl, int timerSec) {
+  CookUnit& u = units[idx];
+  if (u.phase != COOK_IDLE && u.phase != COOK_DONE) {
+    TxEvent.print("Warning: Cook command ignored. Status is not IDLE (장비: ");
+    TxEvent.print(idx + 1); TxEvent.println(")");
+    return false;
+  }
+  unsigned long water = (unsigned long)constrain(waterMl, 0, (int)COOKER_WATER_MAX_ML);
+  unsigned long fillMs = water * 1000UL / COOKER_FILL_ML_PER_S;
+  u.heatMs = water * COOKER_HEAT_MS_PER_ML;
+  u.holdMs = (unsigned long)constrain(timerSec, 0, (int)COOKER_TIMER_MAX_S) * 1000UL;
+
+  if (fillMs > 0) enterPhase(idx, COOK_FILL, fillMs);
+  else if (u.heatMs > 0) enterPhase(idx, COOK_HEAT, u.heatMs);
+  else enterPhase(idx, COOK_HOLD, u.holdMs);
+  return true;
+}
+
+void cookerStop(uint8_t idx) {
+  CookUnit& u = units[idx];
+  timerCancel(u.phaseTimer);
+  setOutputs(idx, LOW, LOW);
+  u.phase = COOK_IDLE;
+}
+
+void cookerAbort(uint8_t idx) {
+  CookUnit& u = units[idx];
+  if (u.phase == COOK_IDLE || u.phase == COOK_DONE) return;
+  cookerStop(idx);
+  TxEvent.print("오류: 과전류 차단으로 조리 중단 (장비: "); TxEvent.print(idx + 1); TxEvent.println(")");
+}
+
+void cookerReset() {
+  // IDLE 장비의 핀은 다른 장비가 입력으로 쓰고 있을 수 있으므로 건드리지 않음
+  for (uint8_t i = 0; i < MAX_COOKER; i++) {
+    if (units[i].phase != COOK_IDLE) cookerStop(i);
+  }
+}
+
+CookPhase cookerPhase(uint8_t idx) {
+  return (CookPhase)units[idx].phase;
+}
+
+bool cookerHoldsForever(uint8_t idx) {
+  return units[idx].phase == COOK_HOLD && units[idx].holdMs == 0;
+}
+
+// 현재 단계 타이머의 남은 시간 + 아직 시작 안 한 단계 길이.
+// 콜백 지연이 쌓여도 실제 단계 전환을 따라가도록 시작 시점에 고정한 시각은 쓰지 않음
+uint16_t cookerRemainSec(uint8_t idx) {
+  const CookUnit& u = units[idx];
+  if (u.phase == COOK_IDLE || u.phase == COOK_DONE || u.holdMs == 0) return 0;
+  unsigned long left = 0;
+  if (timerActive(u.phaseTimer)) {
+    long due = (long)(u.phaseTimer.due - millis());
+    if (due > 0) left = (unsigned long)due;
+  }
+  if (u.phase == COOK_FILL) left += u.heatMs + u.holdMs;
+  else if (u.phase == COOK_HEAT) left += u.holdMs;
+  return (uint16_t)((left + 999) / 1000);
+}
@@ -0,0 +1,46 @@
+#ifndef COOKER_H
+#define COOKER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// =======================================================
+// === 쿠커 조리 시퀀스 (장비별, 논블로킹)
+// === - FILL : 급수 (COOKER_WTR_SIG), water(ml) / COOKER_FILL_ML_PER_S 초
+// === - HEAT : 인덕션 (COOKER_IND_SIG) 예열, water(ml) x COOKER_HEAT_MS_PER_ML
+// === - HOLD : 인덕션 유지 timer(초). timer 0 이면 stopcook 까지 유지
+// === - DONE : 출력 끔. 다음 startcook / stopcook 까지 유지
+// === - 단계 전환은 타이머 휠(timerwheel.h) 콜백. 과전류 래치 시 protectPoll() 이
+// ===   즉시 cookerAbort() 로 중단 (HOLD 처럼 끝이 없는 단계도 멈춤)
+// === - 텔레메트리: work = 단계(CookPhase), remain = 완료까지 남은 초
+// =======================================================
+
+enum CookPhase : uint8_t {
+  COOK_IDLE = 0,
+  COOK_FILL,
+  COOK_HEAT,
+  COOK_HOLD,
+  COOK_DONE
+};
+
+/** @brief 조리 시작 (IDLE/DONE 일 때만) @return 시작했으면 true */
+bool cookerStart(uint8_t idx, int waterMl, int timerSec);
+
+/** @brief 조리 중단 + 출력 끔 (IDLE 로) */
+void cookerStop(uint8_t idx);
+
+/** @brief 과전류 차단 시 진행 중인 시퀀스 중단 (protectPoll 에서, loop 전용) */
+void cookerAbort(uint8_t idx);
+
+/** @brief 모든 장비 IDLE (설정 변경 시) */
+void cookerReset();
+
+CookPhase cookerPhase(uint8_t idx);
+
+/** @brief timer 0 으로 HOLD 중 (stopcook 까지 유지, 완료 이벤트 없음) */
+bool cookerHoldsForever(uint8_t idx);
+
+/** @brief 완료까지 남은 시간 (초, 올림). 단계 타이머 기준, 종료 시각이 없으면 0 */
+uint16_t cookerRemainSec(uint8_t idx);
+
+#endif // COOKER_H
@@ -0,0 +1,235 @@
+#include <Arduino.h>
+#include "dispatch.h"
+#include "protocol.h"
+#include "binproto.h"
+#include "state.h"
+#include "txbuffer.h"
+#include "protect.h"
+#include "motor.h"
+#include "supervisor.h"
+#include "cooker.h"
+#include "recipe.h"
+#include "measure.h"
+#include "nvconfig.h"
+#include "evlog.h"
+#include "telemetry.h"
+
+const char* const COMMAND_ARG_NAMES[ARG_COUNT] = { "time", "water", "timer" };
+const char* const COMMAND_STATUS_NAMES[CMD_STATUS_COUNT] = {
+  "ok", "crc", "function", "length", "control", "arg", "rejected"
+};
+
+// =======================================================
+// === 1. 명령 핸들러 (start*/stop* 함수에 인자 전달, 시작 거부는 CMD_ERR_REJECTED)
+// =======================================================
+
+static uint8_t cmdCupStart(uint8_t idx, const CommandArgs&)    { return startCupDispense(idx) ? CMD_OK : CMD_ERR_REJECTED; }
+static uint8_t cmdCupStop(uint8_t idx, const CommandArgs&)     { stopCupDispense(idx); return CMD_OK; }
+static uint8_t cmdRamenEject(uint8_t idx, const CommandArgs&)  { return startRamenEject(idx) ? CMD_OK : CMD_ERR_REJECTED; }
+static uint8_t cmdRamenRise(uint8_t idx, const CommandArgs&)   { return startRamenRise(idx) ? CMD_OK : CMD_ERR_REJECTED; }
+static uint8_t cmdRamenInit(uint8_t idx, const CommandArgs&)   { return startRamenInit(idx) ? CMD_OK : CMD_ERR_REJECTED; }
+static uint8_t cmdRamenStop(uint8_t idx, const CommandArgs&)   { stopRamen(idx); return CMD_OK; }
+static uint8_t cmdPowderStart(uint8_t idx, const CommandArgs& a) {
+  return startPowderDispense(idx, (unsigned long)a.v[ARG_TIME] * 100) ? CMD_OK : CMD_ERR_REJECTED;
+}
+static uint8_t cmdPowderStop(uint8_t idx, const CommandArgs&)  { stopPowderDispense(idx); return CMD_OK; }
+static uint8_t cmdCookerStart(uint8_t idx, const CommandArgs& a) {
+  return startCook(idx, a.v[ARG_WATER], a.v[ARG_TIMER]) ? CMD_OK : CMD_ERR_REJECTED;
+}
+static uint8_t cmdCookerStop(uint8_t idx, const CommandArgs&)  { stopCook(idx); return CMD_OK; }
+static uint8_t cmdOutletOpen(uint8_t idx, const CommandArgs&)  { return startOutletOpen(idx) ? CMD_OK : CMD_ERR_REJECTED; }
+static uint8_t cmdOutletClose(uint8_t idx, const CommandArgs&) { return startOutletClose(idx) ? CMD_OK : CMD_ERR_REJECTED; }
+static uint8_t cmdOutletStop(uint8_t idx, const CommandArgs&)  { stopOutlet(idx); return CMD_OK; }
+
+// ----- 진행 상태 (check* 함수가 끝낸 동작을 동작 감시 슬롯으로 판정) -----
+static uint8_t motionProgress(uint8_t act, uint8_t idx) {
+  if (protectTripped(act, idx)) return STEP_FAILED;
+  switch (motionState(act, idx)) {
+    case MOTION_RUNNING: return STEP_RUNNING;
+    case MOTION_FAULT:   return STEP_FAILED;
+    default:             return STEP_DONE;
+  }
+}
+static uint8_t progCup(uint8_t idx)      { return motionProgress(ACT_CUP, idx); }
+static uint8_t progRamenUp(uint8_t idx)  { return motionProgress(ACT_RAMEN_UP, idx); }
+static uint8_t progRamenEj(uint8_t idx)  { return motionProgress(ACT_RAMEN_EJ, idx); }
+static uint8_t progOutlet(uint8_t idx)   { return motionProgress(ACT_OUTLET, idx); }
+static uint8_t progPowder(uint8_t idx) {
+  if (protectTripped(ACT_POWDER, idx)) return STEP_FAILED;
+  return powderDispensing(idx) ? STEP_RUNNING : STEP_DONE;
+}
+static uint8_t progCooker(uint8_t idx) {
+  switch (cookerPhase(idx)) {
+    case COOK_IDLE: return STEP_FAILED;   // 시작 거부 또는 중단됨
+    case COOK_DONE: return STEP_DONE;
+    case COOK_HOLD: return cookerHoldsForever(idx) ? STEP_DONE : STEP_RUNNING;   // timer 0: 유지 상태로 다음 단계
+    default:        return STEP_RUNNING;
+  }
+}
+
+// =======================================================
+// === 2. 명령 테이블 (순서 무관, 키는 컴파일 타임에 계산)
+// =======================================================
+
+#define DEVICE(name, id, json) { fnv1a(name), name, id, json }
+
+static constexpr DeviceSpec DEVICES[] = {
+  DEVICE("setting", DEV_SYSTEM, handleSettingJson),
+  DEVICE("query",   DEV_SYSTEM, handleQueryJson),
+  DEVICE("stats",   DEV_SYSTEM, handleStatsCommand),
+  DEVICE("protect", DEV_SYSTEM, handleProtectJson),
+  DEVICE("motor",   DEV_SYSTEM, handleMotorJson),
+  DEVICE("recipe",  DEV_SYSTEM, handleRecipeJson),
+  DEVICE("measure", DEV_SYSTEM, handleMeasureJson),
+  DEVICE("config",  DEV_SYSTEM, handleConfigJson),
+  DEVICE("evlog",   DEV_SYSTEM, handleEvlogJson),
+  DEVICE("subscribe", DEV_SYSTEM, handleSubscribeJson),
+  DEVICE("cup",     DEV_CUP,    nullptr),
+  DEVICE("ramen",   DEV_RAMEN,  nullptr),
+  DEVICE("powder",  DEV_POWDER, nullptr),
+  DEVICE("cooker",  DEV_COOKER, nullptr),
+  DEVICE("outlet",  DEV_OUTLET, nullptr),
+};
+
+#define COMMAND(dev, devName, fn, op, args, required, handler, progress, reply) \
+  { dispatchKey(devName, fn), dev, fn, op, args, required, handler, progress, reply }
+
+static constexpr CommandSpec COMMANDS[] = {
+  COMMAND(DEV_CUP,    "cup",    "startdispense", BIN_OP_CUP_STARTDISPENSE,    0, 0, cmdCupStart, progCup, "cup startdispense"),
+  COMMAND(DEV_CUP,    "cup",    "stopdispense",  BIN_OP_CUP_STOPDISPENSE,     0, 0, cmdCupStop, nullptr, "cup stopdispense"),
+  COMMAND(DEV_RAMEN,  "ramen",  "startdispense", BIN_OP_RAMEN_STARTDISPENSE,  0, 0, cmdRamenEject, progRamenEj, "ramen startdispense"),
+  COMMAND(DEV_RAMEN,  "ramen",  "readydispense", BIN_OP_RAMEN_READYDISPENSE,  0, 0, cmdRamenRise, progRamenUp, "ramen readydispense"),
+  COMMAND(DEV_RAMEN,  "ramen",  "initdispense",  BIN_OP_RAMEN_INITDISPENSE,   0, 0, cmdRamenInit, progRamenUp, "ramen initdispense"),
+  COMMAND(DEV_RAMEN,  "ramen",  "stopdispense",  BIN_OP_RAMEN_STOPDISPENSE,   0, 0, cmdRamenStop, nullptr, "ramen stopdispense (ALL STOP)"),
+  COMMAND(DEV_POWDER, "powder", "startdispense", BIN_OP_POWDER_STARTDISPENSE, ARG_BIT(ARG_TIME), ARG_BIT(ARG_TIME),
+          cmdPowderStart, progPowder, "powder startdispense"),
+  COMMAND(DEV_POWDER, "powder", "stopdispense",  BIN_OP_POWDER_STOPDISPENSE,  0, 0, cmdPowderStop, nullptr, "powder stopdispense"),
+  COMMAND(DEV_COOKER, "cooker", "startcook",     BIN_OP_COOKER_STARTCOOK,     ARG_BIT(ARG_WATER) | ARG_BIT(ARG_TIMER), 0,
+          cmdCookerStart, progCooker, "cooker startcook"),
+  COMMAND(DEV_COOKER, "cooker", "stopcook",      BIN_OP_COOKER_STOPCOOK,      0, 0, cmdCookerStop, nullptr, "cooker stopcook"),
+  COMMAND(DEV_OUTLET, "outlet", "opendoor",      BIN_OP_OUTLET_OPENDOOR,      0, 0, cmdOutletOpen, progOutlet, "outlet opendoor"),
+  COMMAND(DEV_OUTLET, "outlet", "closedoor",     BIN_OP_OUTLET_CLOSEDOOR,     0, 0, cmdOutletClose, progOutlet, "outlet closedoor"),
+  COMMAND(DEV_OUTLET, "outlet", "stopoutlet",    BIN_OP_OUTLET_STOPOUTLET,    0, 0, cmdOutletStop, nullptr, "outlet stopoutlet"),
+};
+
+const uint8_t DEVICE_COUNT  = sizeof(DEVICES) / sizeof(DEVICES[0]);
+const uint8_t COMMAND_COUNT = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+const uint8_t OP_INDEX_SIZE = 0x80;   // 호스트 -> 장비 opcode 범위
+
+// 키 중복 검사 (컴파일 타임). 이진 탐색은 키가 유일해야 하므로 충돌하면 빌드 실패.
+// Due 툴체인(gnu++11) 에서도 되도록 단일 return 재귀로 작성
+template <typename T>
+static constexpr bool keyAbsent(const T* table, uint8_t n, uint32_t key, uint8_t j) {
+  return j >= n ? true : (table[j].key != key && keyAbsent(table, n, key, (uint8_t)(j + 1)));
+}
+
+template <typename T>
+static constexpr bool keysUnique(const T* table, uint8_t n, uint8_t i = 0) {
+  return i >= n ? true
+                : (keyAbsent(table, n, table[i].key, (uint8_t)(i + 1)) && keysUnique(table, n, (uint8_t)(i + 1)));
+}
+
+static_assert(keysUnique(DEVICES, sizeof(DEVICES) / sizeof(DEVICES[0])), "dispatch: device name hash collision");
+static_assert(keysUnique(COMMANDS, sizeof(COMMANDS) / sizeof(COMMANDS[0])), "dispatch: device+function hash collision");
+
+// =======================================================
+// === 3. 정렬 인덱스 및 조회
+// =======================================================
+
+static uint8_t deviceOrder[DEVICE_COUNT];
+static uint8_t commandOrder[COMMAND_COUNT];
+static uint8_t opIndex[OP_INDEX_SIZE];
+static bool dispatchReady = false;
+
+// 키 기준 삽입 정렬 (부팅 시 1회, 항목 수십 개). 키 유일성은 위 static_assert 가 보장
+template <typename T>
+static void sortByKey(const T* table, uint8_t* order, uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) order[i] = i;
+  for (uint8_t i = 1; i < n; i++) {
+    uint8_t v = order[i];
+    int8_t j = (int8_t)i - 1;
+    while (j >= 0 && table[order[j]].key > table[v].key) {
+      order[j + 1] = order[j];
+      j--;
+    }
+    order[j + 1] = v;
+  }
+}
+
+template <typename T>
+static const T* searchKey(const T* table, const uint8_t* order, uint8_t n, uint32_t key) {
+  uint8_t lo = 0, hi = n;
+  while (lo < hi) {
+    uint8_t mid = (uint8_t)((lo + hi) / 2);
+    uint32_t k = table[order[mid]].key;
+    if (k == key) return &table[order[mid]];
+    if (k < key) lo = mid + 1;
+    else hi = mid;
+  }
+  return nullptr;
+}
+
+void dispatchBegin() {
+  sortByKey(DEVICES, deviceOrder, DEVICE_COUNT);
+  sortByKey(COMMANDS, commandOrder, COMMAND_COUNT);
+  memset(opIndex, 0xFF, sizeof(opIndex));
+  for (uint8_t i = 0; i < COMMAND_COUNT; i++) {
+    if (COMMANDS[i].op < OP_INDEX_SIZE) opIndex[COMMANDS[i].op] = i;
+  }
+  dispatchReady = true;
+}
+
+const DeviceSpec* findDevice(const char* name) {
+  if (!dispatchReady) dispatchBegin();
+  const DeviceSpec* d = searchKey(DEVICES, deviceOrder, DEVICE_COUNT, fnv1a(name));
+  // 해시가 같은 다른 문자열 배제
+  return (d && strcmp(d->name, name) == 0) ? d : nullptr;
+}
+
+const CommandSpec* findCommand(const DeviceSpec* dev, const char* function) {
+  if (!dispatchReady) dispatchBegin();
+  uint32_t key = fnv1a(function, fnv1a("/", dev->key));
+  const CommandSpec* c = searchKey(COMMANDS, commandOrder, COMMAND_COUNT, key);
+  return (c && c->device == dev->id && strcmp(c->function, function) == 0) ? c : nullptr;
+}
+
+const CommandSpec* findCommandByOp(uint8_t op) {
+  if (!dispatchReady) dispatchBegin();
+  if (op >= OP_INDEX_SIZE || opIndex[op] == 0xFF) return nullptr;
+  return &COMMANDS[opIndex[op]];
+}
+
+uint8_t deviceCount(uint8_t device) {
+  switch (device) {
+    case DEV_CUP:    return current.cup;
+    case DEV_RAMEN:  return current.ramen;
+    case DEV_POWDER: return current.powder;
+    case DEV_COOKER: return current.cooker;
+    case DEV_OUTLET: return current.outlet;
+    default:         return 0;
+  }
+}
+
+/**
+ * @brief control 범위와 필수 인자를 검사한 뒤 핸들러 실행
+ */
+static uint8_t checkAndRun(const CommandSpec* cmd, int control, const CommandArgs& args) {
+  if (control <= 0 || control > deviceCount(cmd->device)) return CMD_ERR_CONTROL;
+  for (uint8_t a = 0; a < ARG_COUNT; a++) {
+    if ((cmd->required & ARG_BIT(a)) && args.v[a] == 0) return CMD_ERR_ARG;
+  }
+  return cmd->handler((uint8_t)(control - 1), args);
+}
+
+uint8_t executeCommand(const CommandSpec* cmd, int control, const CommandArgs& args) {
+  uint8_t status = checkAndRun(cmd, control, args);
+  evlogPut(EV_CMD, cmd->op, (uint16_t)((uint8_t)control | (status << 8)));
+  return status;
+}
+
+void commandArgsFromJson(const CommandSpec* cmd, JsonVariantConst src, CommandArgs& out) {
+  for (uint8_t a = 0; a < ARG_COUNT; a++) {
+    long v = (cmd->args & ARG_BIT(a)) ? (src[COMMAND_ARG_NAMES[a]] | 0L) : 0L;
+    out.v[a] = (uint16_t)(v < 0 ? 0 : (v > 0xFFFF ? 0xFFFF : v));
+  }
+}
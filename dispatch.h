@@ -0,0 +1,101 @@
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// =======================================================
+// === 테이블 기반 명령 디스패치
+// === - 장비/함수 이름은 컴파일 시 FNV-1a 해시 키로 변환되어 플래시 테이블에 저장
+// === - dispatchBegin() 에서 키 정렬 인덱스를 만들고, 조회는 해시 1회 + 이진 탐색
+// === - 명령 추가 = dispatch.cpp 의 COMMANDS[] 에 한 줄 추가 (인자 스키마 포함)
+// === - JSON 경로(parseAndDispatch)와 바이너리 경로(binDispatch)가 같은 테이블을 사용
+// =======================================================
+
+enum DeviceId : uint8_t {
+  DEV_CUP = 0,
+  DEV_RAMEN,
+  DEV_POWDER,
+  DEV_COOKER,
+  DEV_OUTLET,
+  DEV_SYSTEM     // setting/query/stats 등 JSON 문서를 직접 받는 명령
+};
+
+// 명령 처리 결과 (바이너리 ACK 의 상태 코드와 동일한 값)
+enum CommandStatus : uint8_t {
+  CMD_OK = 0,
+  CMD_ERR_CRC,
+  CMD_ERR_OPCODE,    // 알 수 없는 장비/함수/opcode
+  CMD_ERR_LENGTH,
+  CMD_ERR_CONTROL,   // control 번호가 설정된 장비 수 범위를 벗어남
+  CMD_ERR_ARG,       // 필수 인자 누락/0
+  CMD_ERR_REJECTED,  // 값 검사 거부(setting 등) 또는 장비가 시작 거부(동작 중, FAULT)
+  CMD_STATUS_COUNT
+};
+
+extern const char* const COMMAND_STATUS_NAMES[CMD_STATUS_COUNT];   // JSON nack 의 "error"
+
+// ----- 인자 스키마 -----
+enum CommandArg : uint8_t {
+  ARG_TIME = 0,   // powder: x100ms
+  ARG_WATER,      // cooker
+  ARG_TIMER,      // cooker
+  ARG_COUNT
+};
+#define ARG_BIT(a) ((uint8_t)(1u << (a)))
+
+struct CommandArgs {
+  uint16_t v[ARG_COUNT];
+};
+
+extern const char* const COMMAND_ARG_NAMES[ARG_COUNT];
+
+// 시작한 명령의 진행 상태 (레시피 단계 완료 판정, recipe.h)
+enum StepStatus : uint8_t {
+  STEP_RUNNING = 0,
+  STEP_DONE,
+  STEP_FAILED
+};
+
+typedef uint8_t (*CommandHandler)(uint8_t idx, const CommandArgs& args);
+typedef uint8_t (*CommandProgress)(uint8_t idx);   // StepStatus
+typedef bool (*JsonHandler)(JsonVariantConst doc);
+
+struct DeviceSpec {
+  uint32_t key;
+  const char* name;
+  uint8_t id;
+  JsonHandler json;        // DEV_SYSTEM 전용
+};
+
+struct CommandSpec {
+  uint32_t key;            // dispatchKey(장비, 함수)
+  uint8_t device;
+  const char* function;
+  uint8_t op;              // 바이너리 opcode (binproto.h)
+  uint8_t args;            // ARG_BIT 조합: 받는 인자 (바이너리 payload 순서 = 비트 순서)
+  uint8_t required;        // 그 중 0 이면 안 되는 인자
+  CommandHandler handler;
+  CommandProgress progress; // nullptr = 즉시 완료 (정지 명령 등)
+  const char* reply;       // JSON 경로의 성공 응답
+};
+
+// ----- 컴파일 타임 해시 (C++11 constexpr) -----
+constexpr uint32_t fnv1a(const char* s, uint32_t h = 2166136261u) {
+  return *s ? fnv1a(s + 1, (h ^ (uint8_t)*s) * 16777619u) : h;
+}
+constexpr uint32_t dispatchKey(const char* device, const char* function) {
+  return fnv1a(function, fnv1a("/", fnv1a(device)));
+}
+
+void dispatchBegin();
+const DeviceSpec* findDevice(const char* name);
+const CommandSpec* findCommand(const DeviceSpec* dev, const char* function);
+const CommandSpec* findCommandByOp(uint8_t op);
+uint8_t deviceCount(uint8_t device);
+uint8_t executeCommand(const CommandSpec* cmd, int control, const CommandArgs& args);
+
+/** @brief JSON 객체에서 cmd 의 인자 스키마대로 인자 추출 (없으면 0, 0~65535 로 제한) */
+void commandArgsFromJson(const CommandSpec* cmd, JsonVariantConst src, CommandArgs& out);
+
+#endif // DISPATCH_H
@@ -0,0 +1,223 @@
+#include <Arduino.h>
+#include <string.h>
+#include "encoder.h"
+#include "state.h"
+#include "txbuffer.h"
+#include "motor.h"
+#include "supervisor.h"
+#include "tick.h"
+#include "evlog.h"
+
+// (이전 AB << 2 | 현재 AB) -> 증감. 2 는 불가능한 전이(A/B 동시 변화) 표시
+static const int8_t QDEC_TABLE[16] = {
+//  cur: 00  01  10  11
+         0, +1, -1,  2,   // prev 00
+        -1,  0,  2, +1,   // prev 01
+        +1,  2,  0, -1,   // prev 10
+         2, -1, +1,  0    // prev 11
+};
+
+struct EncoderChannel {
+#ifdef ARDUINO_ARCH_SAM
+  Pio* portA;            // 핀 읽기는 PIO_PDSR 직접 접근 (digitalRead 대비 수십 배 빠름)
+  Pio* portB;
+  uint32_t maskA;
+  uint32_t maskB;
+#endif
+  uint8_t pinA;
+  uint8_t pinB;
+  uint8_t ab;                 // 마지막 AB 상태
+  volatile int32_t count;
+  volatile uint32_t errors;
+  volatile uint32_t edgeUs;   // 마지막 에지 시각 (micros)
+};
+
+// tick 전용 추정/감시 상태 (tick 컨텍스트에서만 씀)
+struct EncoderMotion {
+  int32_t count;          // 직전 추정 시점의 카운트
+  uint32_t edgeUs;        // 직전 추정에 쓴 마지막 에지 시각
+  int32_t velQ8;          // 필터링된 속도 (count/s, Q8)
+  int32_t accel;          // count/s^2
+  volatile int32_t velocity;
+  uint8_t driven;         // 0: 정지, 1: 상승, 2: 하강 (RAMEN_UP_*_OUT)
+  uint16_t drivenTicks;   // 구동 시작 후 tick 수 (기동 유예)
+  uint16_t slowTicks;     // 연속 저속 tick 수
+};
+
+static EncoderChannel channels[ENCODER_UNITS];
+static EncoderMotion motion[ENCODER_UNITS];
+static uint8_t activeUnits = 0;
+static volatile uint8_t stalledMask = 0;   // tick 에서 세우고 encoderPoll() 에서 보고
+
+static inline uint8_t readAB(const EncoderChannel& c) {
+#ifdef ARDUINO_ARCH_SAM
+  return (uint8_t)(((c.portA->PIO_PDSR & c.maskA) ? 2 : 0) | ((c.portB->PIO_PDSR & c.maskB) ? 1 : 0));
+#else
+  return (uint8_t)((digitalRead(c.pinA) ? 2 : 0) | (digitalRead(c.pinB) ? 1 : 0));
+#endif
+}
+
+// A/B 어느 쪽 인터럽트든 같은 처리 (두 핀을 모두 읽어 전이 판단)
+static inline void encoderStep(EncoderChannel& c) {
+  uint8_t ab = readAB(c);
+  int8_t d = QDEC_TABLE[(c.ab << 2) | ab];
+  c.ab = ab;
+  if (d == 2) c.errors = c.errors + 1;
+  else if (d != 0) {
+    c.count = c.count + d;
+    c.edgeUs = micros();
+  }
+}
+
+// attachInterrupt 는 인자 없는 함수만 받으므로 장비별 ISR 을 템플릿으로 생성
+template <uint8_t U>
+static void encoderIsr() { encoderStep(channels[U]); }
+
+static void (* const ENCODER_ISRS[ENCODER_UNITS])(void) = {
+  encoderIsr<0>, encoderIsr<1>, encoderIsr<2>, encoderIsr<3>
+};
+
+void encoderBegin(uint8_t n) {
+  if (n > ENCODER_UNITS) n = ENCODER_UNITS;
+  for (uint8_t u = 0; u < n; u++) {
+    EncoderChannel& c = channels[u];
+    c.pinA = RAMEN_ENCORDER[u * 2];
+    c.pinB = RAMEN_ENCORDER[u * 2 + 1];
+    pinMode(c.pinA, INPUT_PULLUP);
+    pinMode(c.pinB, INPUT_PULLUP);
+#ifdef ARDUINO_ARCH_SAM
+    c.portA = g_APinDescription[c.pinA].pPort;
+    c.maskA = g_APinDescription[c.pinA].ulPin;
+    c.portB = g_APinDescription[c.pinB].pPort;
+    c.maskB = g_APinDescription[c.pinB].ulPin;
+#endif
+
+    noInterrupts();
+    c.ab = readAB(c);
+    c.count = 0;
+    c.errors = 0;
+    c.edgeUs = micros();
+    memset(&motion[u], 0, sizeof(motion[u]));
+    motion[u].edgeUs = c.edgeUs;
+    interrupts();
+
+    attachInterrupt(digitalPinToInterrupt(c.pinA), ENCODER_ISRS[u], CHANGE);
+    attachInterrupt(digitalPinToInterrupt(c.pinB), ENCODER_ISRS[u], CHANGE);
+  }
+  activeUnits = n;
+}
+
+int32_t encoderRead(uint8_t unit) {
+  return channels[unit].count;
+}
+
+void encoderWrite(uint8_t unit, int32_t value) {
+  noInterrupts();
+  // 추정기 기준값도 같이 옮겨 속도가 튀지 않게
+  motion[unit].count += value - channels[unit].count;
+  channels[unit].count = value;
+  interrupts();
+}
+
+uint32_t encoderErrors(uint8_t unit) {
+  return channels[unit].errors;
+}
+
+int32_t encoderVelocity(uint8_t unit) {
+  return motion[unit].velocity;
+}
+
+int32_t encoderAccel(uint8_t unit) {
+  return motion[unit].accel;
+}
+
+// =======================================================
+// === 속도 추정 + 정체 감시 (고정 주기 tick)
+// === - 이번 tick 에 에지가 있으면: (카운트 차) / (에지 시각 차)
+// ===   -> 고속에서는 카운트 차, 저속에서는 에지 주기 측정이 되는 M/T 방식
+// === - 에지가 없으면: 마지막 에지 이후 경과 시간으로 상한을 두어 0 으로 감쇠
+// =======================================================
+
+static void estimate(uint8_t u, uint32_t nowUs) {
+  EncoderChannel& c = channels[u];
+  EncoderMotion& m = motion[u];
+
+  noInterrupts();
+  int32_t count = c.count;
+  uint32_t edgeUs = c.edgeUs;
+  interrupts();
+
+  int32_t raw;   // count/s
+  int32_t dCount = count - m.count;
+  if (dCount != 0) {
+    uint32_t dt = edgeUs - m.edgeUs;
+    if (dt == 0) dt = 1;
+    raw = (int32_t)(((int64_t)dCount * 1000000LL) / (int32_t)dt);
+    m.count = count;
+    m.edgeUs = edgeUs;
+  } else {
+    // 다음 에지가 지금 온다고 해도 이 속도를 넘을 수 없음
+    uint32_t since = nowUs - m.edgeUs;
+    int32_t bound = (since > 0) ? (int32_t)(1000000UL / since) : 0;
+    int32_t prev = m.velQ8 >> 8;
+    raw = prev;
+    if (prev > bound) raw = bound;
+    else if (prev < -bound) raw = -bound;
+  }
+
+  // 1차 IIR (alpha = 1/2^ENCODER_VEL_FILTER_SHIFT), Q8
+  int32_t prevVel = m.velQ8 >> 8;
+  m.velQ8 += ((raw << 8) - m.velQ8) >> ENCODER_VEL_FILTER_SHIFT;
+  m.velocity = m.velQ8 >> 8;
+  m.accel = (m.velocity - prevVel) * (int32_t)FAST_TICK_HZ;
+}
+
+static void stallCheck(uint8_t u) {
+  EncoderMotion& m = motion[u];
+  uint8_t driven = 0;
+  if (motorOn(RAMEN_UP_FWD_OUT[u])) driven = 1;
+  else if (motorOn(RAMEN_UP_REV_OUT[u])) driven = 2;
+
+  if (driven != m.driven) {   // 구동 시작/방향 전환/정지 -> 유예부터 다시
+    m.driven = driven;
+    m.drivenTicks = 0;
+    m.slowTicks = 0;
+  }
+  if (!driven) return;
+  if (m.drivenTicks < 0xFFFF) m.drivenTicks++;
+  if (m.drivenTicks < RAMEN_STALL_GRACE_TICKS) return;
+
+  int32_t speed = (m.velocity < 0) ? -m.velocity : m.velocity;
+  m.slowTicks = (speed < RAMEN_STALL_MIN_CPS) ? (uint16_t)(m.slowTicks + 1) : 0;
+  if (m.slowTicks >= RAMEN_STALL_TICKS) {
+    evlogPut(EV_STALL, u, (uint16_t)speed);
+    motorStop(RAMEN_UP_FWD_OUT[u]);
+    motorStop(RAMEN_UP_REV_OUT[u]);
+    m.driven = 0;
+    m.slowTicks = 0;
+    stalledMask |= (uint8_t)(1 << u);
+  }
+}
+
+void encoderTick() {
+  uint32_t nowUs = micros();
+  for (uint8_t u = 0; u < activeUnits; u++) {
+    estimate(u, nowUs);
+    stallCheck(u);
+  }
+}
+
+void encoderPoll() {
+  if (!stalledMask) return;
+  noInterrupts();
+  uint8_t mask = stalledMask;
+  stalledMask = 0;
+  interrupts();
+  for (uint8_t u = 0; u < ENCODER_UNITS; u++) {
+    if (mask & (1 << u)) {
+      motionAbort(ACT_RAMEN_UP, u);   // stopdispense 로 해제할 때까지 재기동 거부
+      TxEvent.print("오류: 리프트 정체 감지. 모터 정지 (장비: "); TxEvent.print(u + 1);
+      TxEvent.print(", 위치: "); TxEvent.print(encoderRead(u)); TxEvent.println(")");
+    }
+  }
+}
@@ -0,0 +1,45 @@
+#ifndef ENCODER_H
+#define ENCODER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// =======================================================
+// === 면 리프트 직교(A/B) 엔코더 엔진 (RAMEN_ENCORDER[8] = 장비 4개 x A/B)
+// === - A/B 양쪽 CHANGE 인터럽트, 이전/현재 AB 상태(4비트)로 증감을 표에서 조회
+// === - 장비별 32비트 카운트 (Cortex-M3 정렬 32비트 읽기는 원자적)
+// === - A/B 가 동시에 바뀐 전이(놓친 에지)는 세지 않고 오류로 집계
+// === - 정방향(상승) = AB 00 -> 01 -> 11 -> 10, 카운트 증가
+// === - 고정 주기 tick(tick.h, FAST_TICK_HZ)에서 속도/가속도(고정소수점) 추정과
+// ===   리프트 정체(stall) 감시
+// =======================================================
+
+const uint8_t ENCODER_UNITS = MAX_RAMEN;
+
+/**
+ * @brief 장비 0..n-1 의 엔코더 핀 설정 및 인터럽트 연결, 카운트 0 으로 초기화
+ */
+void encoderBegin(uint8_t n);
+
+/** @brief 현재 카운트 (ISR 과 경합 없이 읽음) */
+int32_t encoderRead(uint8_t unit);
+
+/** @brief 카운트 강제 설정 (원점 스위치 도달 시 0) */
+void encoderWrite(uint8_t unit, int32_t value);
+
+/** @brief 놓친 에지(불가능한 전이) 누적 수 */
+uint32_t encoderErrors(uint8_t unit);
+
+/** @brief 속도 (count/s, + = 상승) */
+int32_t encoderVelocity(uint8_t unit);
+
+/** @brief 가속도 (count/s^2) */
+int32_t encoderAccel(uint8_t unit);
+
+/** @brief 속도 추정 + 정체 감시 (fastTick 에서 호출, 인터럽트 컨텍스트) */
+void encoderTick();
+
+/** @brief tick 에서 정체로 모터를 끊은 장비를 TxEvent 로 보고 (loop 에서 호출) */
+void encoderPoll();
+
+#endif // ENCODER_H
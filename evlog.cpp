@@ -0,0 +1,122 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "evlog.h"
+#include "txbuffer.h"
+
+static_assert((EVLOG_SIZE & (EVLOG_SIZE - 1)) == 0, "EVLOG_SIZE must be a power of two");
+
+const char* const EVLOG_TYPE_NAMES[EV_TYPE_COUNT] = {
+  "none", "boot", "setting", "cmd", "motor_start", "motor_stop",
+  "limit", "trip", "peak", "timeout", "stall"
+};
+
+EvRecord evlogRing[EVLOG_SIZE];
+volatile uint32_t evlogHead = 0;
+
+uint8_t evlogCopy(uint32_t seq, EvRecord* out, uint8_t n, uint32_t& first) {
+  noInterrupts();
+  uint32_t head = evlogHead;
+  uint32_t oldest = head > EVLOG_SIZE ? head - EVLOG_SIZE : 0;
+  if (seq < oldest) seq = oldest;
+  if (seq > head) seq = head;
+  uint8_t count = (head - seq < n) ? (uint8_t)(head - seq) : n;
+  for (uint8_t i = 0; i < count; i++) out[i] = evlogRing[(seq + i) & (EVLOG_SIZE - 1)];
+  interrupts();
+  first = seq;
+  return count;
+}
+
+void evlogEncode(const EvRecord& r, uint8_t out[8]) {
+  out[0] = (uint8_t)r.us;
+  out[1] = (uint8_t)(r.us >> 8);
+  out[2] = (uint8_t)(r.us >> 16);
+  out[3] = (uint8_t)(r.us >> 24);
+  out[4] = r.type;
+  out[5] = r.arg;
+  out[6] = (uint8_t)r.value;
+  out[7] = (uint8_t)(r.value >> 8);
+}
+
+void evlogDecode(const uint8_t in[8], EvRecord& r) {
+  r.us = (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+  r.type = in[4];
+  r.arg = in[5];
+  r.value = (uint16_t)(in[6] | (in[7] << 8));
+}
+
+// =======================================================
+// === {"device":"evlog"} 명령
+// =======================================================
+
+static void sendLine(uint32_t seq, const EvRecord* recs, uint8_t n) {
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+  char hex[EVLOG_LINE_RECORDS * 16 + 1];
+  uint8_t b[8];
+  for (uint8_t i = 0; i < n; i++) {
+    evlogEncode(recs[i], b);
+    for (uint8_t k = 0; k < 8; k++) {
+      hex[i * 16 + k * 2] = HEX_DIGITS[b[k] >> 4];
+      hex[i * 16 + k * 2 + 1] = HEX_DIGITS[b[k] & 0x0F];
+    }
+  }
+  hex[n * 16] = '\0';
+
+  StaticJsonDocument<96> doc;
+  doc["device"] = "evlog";
+  doc["seq"] = seq;
+  doc["hex"] = (const char*)hex;   // 복사하지 않음 (직렬화 전까지 유효)
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+static void dump(uint32_t from, uint8_t count) {
+  EvRecord recs[EVLOG_LINE_RECORDS];
+  uint32_t seq = from;
+  while (count > 0) {
+    uint32_t first;
+    uint8_t n = evlogCopy(seq, recs, count < EVLOG_LINE_RECORDS ? count : EVLOG_LINE_RECORDS, first);
+    seq = first + n;   // 범위 밖 from 은 oldest/head 로 맞춰짐
+    if (n == 0) break;
+    sendLine(first, recs, n);
+    count -= n;
+  }
+
+  StaticJsonDocument<96> doc;
+  doc["device"] = "evlog";
+  doc["next"] = seq;
+  doc["head"] = evlogHead;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+bool handleEvlogJson(JsonVariantConst doc) {
+  const char* func = doc["function"] | "status";
+  uint32_t head = evlogHead;
+  uint32_t oldest = head > EVLOG_SIZE ? head - EVLOG_SIZE : 0;
+
+  if (strcmp(func, "dump") == 0) {
+    uint32_t from = doc["from"] | oldest;
+    long count = doc["count"] | (long)EVLOG_DUMP_MAX;
+    if (count < 1 || count > EVLOG_DUMP_MAX) count = EVLOG_DUMP_MAX;
+    dump(from, (uint8_t)count);
+    return true;
+  } else if (strcmp(func, "clear") == 0) {
+    noInterrupts();
+    evlogHead = 0;
+    interrupts();
+    head = oldest = 0;
+  } else if (strcmp(func, "status") != 0) {
+    TxEvent.println("unknown evlog function");
+    return false;
+  }
+
+  StaticJsonDocument<128> reply;
+  reply["device"] = "evlog";
+  reply["head"] = head;
+  reply["oldest"] = oldest;
+  reply["capacity"] = EVLOG_SIZE;
+  reply["us"] = micros();   // 기록 시각과 비교할 현재 시각
+  serializeJson(reply, TxEvent);
+  TxEvent.println();
+  return true;
+}
@@ -0,0 +1,85 @@
+#ifndef EVLOG_H
+#define EVLOG_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// =======================================================
+// === 이벤트 기록기 (flight recorder)
+// === - RAM 링 버퍼(EVLOG_SIZE)에 8바이트 바이너리 기록을 계속 덮어씀
+// ===   평소에는 아무것도 보내지 않음 (시리얼 부하 없음)
+// === - 기록 = { micros() 시각, 종류, arg, value } , evlogPut() 은 인터럽트
+// ===   컨텍스트에서도 호출 가능 (PRIMASK 저장/복원 사이에서 슬롯 예약 + 기록)
+// === - 일련번호(seq) = 지금까지 기록한 수. 링에는 최근 EVLOG_SIZE 개가 남음
+// === - 명령: {"device":"evlog","function":"status|dump|clear"}
+// ===   dump: "from" (seq, 생략 시 가장 오래된 것), "count" (최대 EVLOG_DUMP_MAX)
+// ===   -> {"device":"evlog","seq":첫 seq,"hex":"기록 x N (각 8B, LE)"} 줄들
+// ===   -> {"device":"evlog","next":다음 seq,"head":..} (next == head 면 끝)
+// === - 호스트 해독: botty_sim --decode-evlog 캡처파일 (host/evlog_decode.cpp)
+// =======================================================
+
+enum EvType : uint8_t {
+  EV_NONE = 0,
+  EV_BOOT,         // arg: 리셋 원인 (RSTC RSTTYP)
+  EV_SETTING,      // value: cup | ramen<<3 | powder<<6 | cooker<<10 | outlet<<13
+  EV_CMD,          // arg: opcode (binproto.h), value: control | CommandStatus<<8
+  EV_MOTOR_START,  // arg: 출력 핀, value: ActuatorId
+  EV_MOTOR_STOP,   // arg: 출력 핀
+  EV_LIMIT,        // arg: 스위치 핀, value: 레벨 (모든 에지)
+  EV_TRIP,         // arg: EV_TARGET, value: 차단 시점 전류 (ADC count)
+  EV_PEAK,         // arg: EV_TARGET, value: 한 번 켜진 동안의 최대 전류
+  EV_TIMEOUT,      // arg: EV_TARGET, value: 경과 ms
+  EV_STALL,        // arg: 면 장비, value: 정지 직전 속도 (count/s)
+  EV_TYPE_COUNT
+};
+
+extern const char* const EVLOG_TYPE_NAMES[EV_TYPE_COUNT];
+
+// 액추에이터 + 장비 번호를 arg 한 바이트로
+#define EV_TARGET(act, unit) ((uint8_t)(((act) << 4) | (unit)))
+
+struct EvRecord {
+  uint32_t us;
+  uint8_t type;
+  uint8_t arg;
+  uint16_t value;
+};
+
+extern EvRecord evlogRing[EVLOG_SIZE];
+extern volatile uint32_t evlogHead;
+
+/** @brief 기록 추가 (ISR/loop 어디서나, 수십 사이클) */
+static inline void evlogPut(uint8_t type, uint8_t arg, uint16_t value) {
+  uint32_t us = micros();
+#ifdef ARDUINO_ARCH_SAM
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+#endif
+  EvRecord& r = evlogRing[evlogHead & (EVLOG_SIZE - 1)];
+  r.us = us;
+  r.type = type;
+  r.arg = arg;
+  r.value = value;
+  evlogHead = evlogHead + 1;
+#ifdef ARDUINO_ARCH_SAM
+  __set_PRIMASK(primask);
+#endif
+}
+
+/**
+ * @brief seq 부터 최대 n 개를 복사 (덮어써진 앞부분은 건너뜀)
+ * @param first 실제로 복사한 첫 seq
+ * @return 복사한 수
+ */
+uint8_t evlogCopy(uint32_t seq, EvRecord* out, uint8_t n, uint32_t& first);
+
+/** @brief 기록 하나를 8바이트 LE 로 (dump 형식) */
+void evlogEncode(const EvRecord& r, uint8_t out[8]);
+
+/** @brief 8바이트 LE -> 기록 (호스트 해독기) */
+void evlogDecode(const uint8_t in[8], EvRecord& r);
+
+bool handleEvlogJson(JsonVariantConst doc);
+
+#endif // EVLOG_H
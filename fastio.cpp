@@ -0,0 +1,192 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "fastio.h"
+#include "state.h"
+#include "txbuffer.h"
+
+static volatile uint32_t shadow[(FIO_PINS + 31) / 32];
+
+static inline void shadowSet(uint8_t pin, bool on) {
+  uint32_t bit = 1u << (pin & 31);
+#ifdef ARDUINO_ARCH_SAM
+  uint32_t primask = __get_PRIMASK();   // ISR 에서도 불리므로 이전 상태 복원
+  __disable_irq();
+  if (on) shadow[pin >> 5] |= bit; else shadow[pin >> 5] &= ~bit;
+  __set_PRIMASK(primask);
+#else
+  noInterrupts();
+  if (on) shadow[pin >> 5] |= bit; else shadow[pin >> 5] &= ~bit;
+  interrupts();
+#endif
+}
+
+bool fioOutput(uint8_t pin) {
+  if (pin >= FIO_PINS) return false;
+  return (shadow[pin >> 5] >> (pin & 31)) & 1u;
+}
+
+void fioShadow(uint8_t pin, bool on) {
+  if (pin < FIO_PINS) shadowSet(pin, on);
+}
+
+#ifdef ARDUINO_ARCH_SAM
+// =======================================================
+// === SAM3X: PIO 레지스터
+// =======================================================
+
+static Pio* const PORTS[4] = { PIOA, PIOB, PIOC, PIOD };
+const uint8_t NO_PORT = 0xFF;
+
+static uint8_t pinPort[FIO_PINS];   // PORTS 인덱스 (NO_PORT = PIO 핀 아님)
+static uint8_t pinBit[FIO_PINS];
+static uint32_t snapshot[4];
+
+void fioBegin() {
+  for (uint8_t pin = 0; pin < FIO_PINS; pin++) {
+    pinPort[pin] = NO_PORT;
+    pinBit[pin] = 0;
+    if (pin >= PINS_COUNT) continue;
+    const PinDescription& d = g_APinDescription[pin];
+    for (uint8_t p = 0; p < 4; p++) {
+      if (d.pPort == PORTS[p] && d.ulPin != 0) {
+        pinPort[pin] = p;
+        pinBit[pin] = (uint8_t)(31 - __builtin_clz(d.ulPin));
+      }
+    }
+  }
+  fioSnapshot();
+}
+
+void fioSnapshot() {
+  for (uint8_t p = 0; p < 4; p++) snapshot[p] = PORTS[p]->PIO_PDSR;
+}
+
+uint8_t fioRead(uint8_t pin) {
+  if (pin >= FIO_PINS || pinPort[pin] == NO_PORT) return (uint8_t)digitalRead(pin);
+  return (snapshot[pinPort[pin]] >> pinBit[pin]) & 1u ? HIGH : LOW;
+}
+
+uint8_t fioReadNow(uint8_t pin) {
+  if (pin >= FIO_PINS || pinPort[pin] == NO_PORT) return (uint8_t)digitalRead(pin);
+  return (PORTS[pinPort[pin]]->PIO_PDSR >> pinBit[pin]) & 1u ? HIGH : LOW;
+}
+
+void fioWrite(uint8_t pin, uint8_t level) {
+  if (pin >= FIO_PINS || pinPort[pin] == NO_PORT) { digitalWrite(pin, level); return; }
+  Pio* port = PORTS[pinPort[pin]];
+  uint32_t mask = 1u << pinBit[pin];
+  // PIO 가 잡고 있는 출력 핀만 레지스터로. PWM 주변장치에 넘어가 있던 핀은
+  // digitalWrite 가 PIO 로 되돌려 줌 (램프 프로파일을 step 으로 바꾼 경우 등)
+  if ((port->PIO_PSR & mask) && (port->PIO_OSR & mask)) {
+    if (level) port->PIO_SODR = mask; else port->PIO_CODR = mask;
+  } else {
+    digitalWrite(pin, level);
+  }
+  shadowSet(pin, level != LOW);
+}
+
+void fioSync() {
+  for (uint8_t pin = 0; pin < FIO_PINS; pin++) {
+    if (pinPort[pin] == NO_PORT) continue;
+    Pio* port = PORTS[pinPort[pin]];
+    uint32_t mask = 1u << pinBit[pin];
+    shadowSet(pin, (port->PIO_OSR & mask) && (port->PIO_ODSR & mask));
+  }
+}
+
+#else
+// =======================================================
+// === 호스트: Arduino 함수로 대체
+// =======================================================
+
+void fioBegin() {
+}
+
+void fioSnapshot() {
+}
+
+uint8_t fioRead(uint8_t pin) {
+  return (uint8_t)digitalRead(pin);
+}
+
+uint8_t fioReadNow(uint8_t pin) {
+  return (uint8_t)digitalRead(pin);
+}
+
+void fioWrite(uint8_t pin, uint8_t level) {
+  digitalWrite(pin, level);
+  if (pin < FIO_PINS) shadowSet(pin, level != LOW);
+}
+
+void fioSync() {
+  for (uint8_t pin = 0; pin < FIO_PINS; pin++) shadowSet(pin, false);   // pinMode(OUTPUT) 직후 LOW
+}
+
+#endif
+
+// =======================================================
+// === 벤치마크: loop 1회가 하는 디지털 I/O 를 기존 방식 / 새 방식으로 반복
+// === 입력은 설정된 장비의 센서/스위치 전부, 출력은 모터 출력 핀의 "켜져 있나" 확인
+// === (쓰기는 측정하지 않음: 가동 중인 장비의 출력을 바꾸지 않기 위해)
+// =======================================================
+
+static void collectPins(uint8_t* in, uint8_t* nIn, uint8_t* out, uint8_t* nOut) {
+  *nIn = 0;
+  *nOut = 0;
+  for (uint8_t i = 0; i < current.cup; i++) {
+    in[(*nIn)++] = CUP_ROT_IN[i];
+    in[(*nIn)++] = CUP_STOCK_IN[i];
+    out[(*nOut)++] = CUP_MOTOR_OUT[i];
+  }
+  for (uint8_t i = 0; i < current.ramen; i++) {
+    in[(*nIn)++] = RAMEN_UP_TOP_IN[i];
+    in[(*nIn)++] = RAMEN_UP_BTM_IN[i];
+    in[(*nIn)++] = RAMEN_EJ_TOP_IN[i];
+    in[(*nIn)++] = RAMEN_EJ_BTM_IN[i];
+    in[(*nIn)++] = RAMEN_PRESENT_IN[i];
+    out[(*nOut)++] = RAMEN_UP_FWD_OUT[i];
+    out[(*nOut)++] = RAMEN_UP_REV_OUT[i];
+  }
+  for (uint8_t i = 0; i < current.powder; i++) out[(*nOut)++] = POWDER_MOTOR_OUT[i];
+  for (uint8_t i = 0; i < current.outlet; i++) {
+    in[(*nIn)++] = OUTLET_OPEN_IN[i];
+    in[(*nIn)++] = OUTLET_CLOSE_IN[i];
+    out[(*nOut)++] = OUTLET_FWD_OUT[i];
+    out[(*nOut)++] = OUTLET_REV_OUT[i];
+  }
+  in[(*nIn)++] = DOOR_SENSOR1_PIN;
+  in[(*nIn)++] = DOOR_SENSOR2_PIN;
+}
+
+void replyIoBench() {
+  const uint16_t ROUNDS = 1000;
+  uint8_t in[24];
+  uint8_t out[16];
+  uint8_t nIn, nOut;
+  collectPins(in, &nIn, out, &nOut);
+
+  volatile uint32_t sink = 0;
+  uint32_t t0 = micros();
+  for (uint16_t r = 0; r < ROUNDS; r++) {
+    for (uint8_t k = 0; k < nIn; k++) sink += digitalRead(in[k]);
+    for (uint8_t k = 0; k < nOut; k++) sink += digitalRead(out[k]) == HIGH;
+  }
+  uint32_t t1 = micros();
+  for (uint16_t r = 0; r < ROUNDS; r++) {
+    fioSnapshot();
+    for (uint8_t k = 0; k < nIn; k++) sink += fioRead(in[k]);
+    for (uint8_t k = 0; k < nOut; k++) sink += fioOutput(out[k]);
+  }
+  uint32_t t2 = micros();
+
+  StaticJsonDocument<192> doc;
+  doc["device"] = "stats";
+  doc["stage"] = "bench_io";
+  doc["inputs"] = nIn;
+  doc["outputs"] = nOut;
+  doc["rounds"] = ROUNDS;
+  doc["digital_ns"] = (uint32_t)((uint64_t)(t1 - t0) * 1000 / ROUNDS);   // loop 1회분
+  doc["fastio_ns"] = (uint32_t)((uint64_t)(t2 - t1) * 1000 / ROUNDS);
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
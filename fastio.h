@@ -0,0 +1,49 @@
+#ifndef FASTIO_H
+#define FASTIO_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// =======================================================
+// === 포트 레벨 디지털 I/O (SAM3X PIO 레지스터 직접 접근)
+// === - fioBegin(): 핀마다 PIO 포트 번호/비트를 표로 만들어 둠 (g_APinDescription 조회 1회)
+// === - 입력: loop 시작에서 fioSnapshot() 이 PIOA~D 의 PDSR 을 한 번씩 읽고,
+// ===   fioRead() 는 그 스냅샷에서 비트만 꺼냄 (loop 1회 안에서는 같은 값)
+// ===   ISR 처럼 지금 값이 필요하면 fioReadNow()
+// === - 출력: fioWrite() 는 SODR/CODR 한 번 쓰기 (다른 핀과 read-modify-write 경쟁 없음)
+// ===   출력 상태는 그림자 비트맵에 기록 → "모터가 켜져 있나" 는 핀을 읽지 않고 fioOutput()
+// ===   PWM 으로 구동 중인 핀(analogWrite)은 fioShadow() 로 그림자만 맞춤
+// === - 비 SAM(호스트) 빌드는 digitalRead/digitalWrite 로 대체 (스냅샷 없음)
+// === - {"device":"stats","function":"bench_io"}: 기존 방식과 loop 1회분 I/O 시간 비교
+// =======================================================
+
+const uint8_t FIO_PINS = 80;   // Due D0~D53 + A0~A11(54~65) + 여분
+
+/** @brief 핀 표 작성 (setup 에서 1회, 다른 모듈보다 먼저) */
+void fioBegin();
+
+/** @brief 입력 레지스터 스냅샷 (loop 시작에서 1회) */
+void fioSnapshot();
+
+/** @brief 스냅샷 기준 입력 레벨 (HIGH/LOW) */
+uint8_t fioRead(uint8_t pin);
+
+/** @brief 레지스터 즉시 읽기 (인터럽트에서 사용) */
+uint8_t fioReadNow(uint8_t pin);
+
+/** @brief 출력 쓰기 + 그림자 갱신 (인터럽트에서도 사용) */
+void fioWrite(uint8_t pin, uint8_t level);
+
+/** @brief 그림자 출력 상태: 마지막으로 HIGH(또는 PWM 구동)로 쓴 핀이면 true */
+bool fioOutput(uint8_t pin);
+
+/** @brief 핀에 쓰지 않고 그림자만 갱신 (analogWrite 로 구동하는 핀) */
+void fioShadow(uint8_t pin, bool on);
+
+/** @brief 설정 변경(pinMode) 후 실제 출력 레벨로 그림자 재동기 */
+void fioSync();
+
+/** @brief I/O 경로 마이크로벤치마크 결과 보고 */
+void replyIoBench();
+
+#endif // FASTIO_H
@@ -0,0 +1,65 @@
+#include <Arduino.h>
+#include <string.h>
+#include "flash.h"
+
+#ifdef ARDUINO_ARCH_SAM
+// 뱅크1 (0xC0000~) 의 마지막 페이지들. 스케치는 뱅크0 에서 실행되므로 쓰는 동안에도 코드 실행 가능
+static const uint32_t STORE_FIRST_PAGE = IFLASH1_SIZE / IFLASH1_PAGE_SIZE - FLASH_STORE_PAGES;
+
+static uint32_t pageAddr(uint8_t page) {
+  return IFLASH1_ADDR + (STORE_FIRST_PAGE + page) * IFLASH1_PAGE_SIZE;
+}
+
+const uint8_t* flashPage(uint8_t page) {
+  return (const uint8_t*)pageAddr(page);
+}
+
+bool flashPageWrite(uint8_t page, const void* data, uint16_t len) {
+  if (page >= FLASH_STORE_PAGES || len > FLASH_PAGE_SIZE) return false;
+  uint32_t buf[FLASH_PAGE_SIZE / 4];
+  memset(buf, 0xFF, sizeof(buf));
+  if (len) memcpy(buf, data, len);
+
+  uint32_t pageNo = STORE_FIRST_PAGE + page;
+  EFC1->EEFC_FMR = EEFC_FMR_FWS(6);   // 프로그래밍 중 wait state (Due 기본 4 로는 쓰기 실패)
+  if (efc_perform_command(EFC1, EFC_FCMD_CLB, pageNo) != 0) return false;
+
+  // 페이지 주소에 32bit 단위로 쓰면 래치 버퍼에 들어가고, EWP 로 지우고 기록
+  volatile uint32_t* dst = (volatile uint32_t*)pageAddr(page);
+  for (uint16_t i = 0; i < FLASH_PAGE_SIZE / 4; i++) dst[i] = buf[i];
+  if (efc_perform_command(EFC1, EFC_FCMD_EWP, pageNo) != 0) return false;
+  return memcmp(flashPage(page), buf, FLASH_PAGE_SIZE) == 0;
+}
+
+#else
+static uint8_t simFlash[FLASH_STORE_PAGES][FLASH_PAGE_SIZE];
+static bool simReady = false;
+
+const uint8_t* flashPage(uint8_t page) {
+  if (!simReady) {
+    memset(simFlash, 0xFF, sizeof(simFlash));   // 지워진 플래시
+    simReady = true;
+  }
+  return simFlash[page];
+}
+
+bool flashPageWrite(uint8_t page, const void* data, uint16_t len) {
+  if (page >= FLASH_STORE_PAGES || len > FLASH_PAGE_SIZE) return false;
+  flashPage(page);
+  memset(simFlash[page], 0xFF, FLASH_PAGE_SIZE);
+  if (len) memcpy(simFlash[page], data, len);
+  return true;
+}
+#endif
+
+bool flashWrite(uint8_t firstPage, const void* data, uint16_t len) {
+  const uint8_t* src = (const uint8_t*)data;
+  uint8_t page = firstPage;
+  do {
+    uint16_t n = len > FLASH_PAGE_SIZE ? FLASH_PAGE_SIZE : len;
+    if (!flashPageWrite(page++, src, n)) return false;
+    src += n;
+    len -= n;
+  } while (len > 0);
+  return true;
+}
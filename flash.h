@@ -0,0 +1,27 @@
+#ifndef FLASH_H
+#define FLASH_H
+
+#include <Arduino.h>
+
+// =======================================================
+// === 내부 플래시 페이지 저장 영역 (SAM3X EEFC1, 뱅크1 끝 FLASH_STORE_PAGES 페이지)
+// === - 읽기: 메모리 매핑 주소를 그대로 읽음 (flashPage)
+// === - 쓰기: 256B 페이지 단위 erase+write (EWP). 1회 수 ms 동안 loop 정지
+// ===   → 명령으로 저장할 때만 사용 (주기적으로 쓰지 말 것, 페이지당 약 1만 회 수명)
+// === - 스케치 업로드(bossac)는 전체 플래시를 지우므로 저장값도 지워진다
+// === - 호스트 빌드는 RAM 배열로 대체 (프로세스 종료 시 사라짐)
+// =======================================================
+
+const uint16_t FLASH_PAGE_SIZE   = 256;
+const uint8_t  FLASH_STORE_PAGES = 32;   // 8KB, 전부 설정 레코드 슬롯 (nvconfig.cpp)
+
+/** @brief 페이지 내용 (읽기 전용 포인터) */
+const uint8_t* flashPage(uint8_t page);
+
+/** @brief 페이지 전체 쓰기 (len 이후는 0xFF) @return 검증까지 성공하면 true */
+bool flashPageWrite(uint8_t page, const void* data, uint16_t len);
+
+/** @brief firstPage 부터 연속 페이지에 걸쳐 쓰기 (len 이 페이지 경계를 넘는 레코드) */
+bool flashWrite(uint8_t firstPage, const void* data, uint16_t len);
+
+#endif // FLASH_H
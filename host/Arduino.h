@@ -0,0 +1,193 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// =======================================================
+// === 호스트(Linux) 빌드용 Arduino API 대체 헤더
+// === 펌웨어 소스의 #include <Arduino.h> 가 이 파일을 가리키도록
+// === -I host 로 빌드한다. 실제 핀/ADC/시계/시리얼 동작은 hal.h 의
+// === HalBackend 구현(기본: SimBoard)으로 위임된다.
+// =======================================================
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+
+// ArduinoJson 이 Print/String 어댑터를 사용하도록 설정
+#define ARDUINOJSON_ENABLE_ARDUINO_PRINT  1
+#define ARDUINOJSON_ENABLE_ARDUINO_STRING 1
+#define ARDUINOJSON_ENABLE_ARDUINO_STREAM 0
+#define ARDUINOJSON_ENABLE_PROGMEM        0
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE  2
+#define FALLING 3
+#define RISING  4
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+// Arduino Due 핀 번호 체계 (variant.h 와 동일)
+#define NUM_DIGITAL_PINS 92
+static const uint8_t A0  = 54;
+static const uint8_t A1  = 55;
+static const uint8_t A2  = 56;
+static const uint8_t A3  = 57;
+static const uint8_t A4  = 58;
+static const uint8_t A5  = 59;
+static const uint8_t A6  = 60;
+static const uint8_t A7  = 61;
+static const uint8_t A8  = 62;
+static const uint8_t A9  = 63;
+static const uint8_t A10 = 64;
+static const uint8_t A11 = 65;
+static const uint8_t DAC0 = 66;
+static const uint8_t DAC1 = 67;
+
+#define digitalPinToInterrupt(p) (p)
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define PROGMEM
+
+// Arduino.h 의 constrain 매크로와 같은 동작 (min/max 는 <algorithm> 과 충돌하므로 제외)
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ===== 시간 / 핀 / ADC =====
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+void analogReadResolution(int bits);
+void analogWriteResolution(int bits);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// ===== 인터럽트 =====
+void noInterrupts();
+void interrupts();
+// CMSIS PRIMASK 흉내 (1 = 인터럽트 막힘). 중첩 임계 구역의 저장/복원용
+uint32_t __get_PRIMASK();
+void __set_PRIMASK(uint32_t primask);
+void __disable_irq();
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+// ===== String (Arduino WString 의 필요한 부분만) =====
+class String {
+ public:
+  String() {}
+  String(const char* s) : s_(s ? s : "") {}
+  String(const String& o) : s_(o.s_) {}
+  explicit String(char c) : s_(1, c) {}
+  explicit String(int v) : s_(std::to_string(v)) {}
+  explicit String(unsigned int v) : s_(std::to_string(v)) {}
+  explicit String(long v) : s_(std::to_string(v)) {}
+  explicit String(unsigned long v) : s_(std::to_string(v)) {}
+
+  String& operator=(const String& o) { s_ = o.s_; return *this; }
+  String& operator=(const char* s) { s_ = s ? s : ""; return *this; }
+  String& operator+=(const String& o) { s_ += o.s_; return *this; }
+  String& operator+=(const char* s) { if (s) s_ += s; return *this; }
+  String& operator+=(char c) { s_ += c; return *this; }
+  bool concat(const char* s) { if (s) s_ += s; return true; }
+  bool concat(char c) { s_ += c; return true; }
+  bool operator==(const String& o) const { return s_ == o.s_; }
+  bool operator==(const char* s) const { return s && s_ == s; }
+  bool operator!=(const char* s) const { return !(*this == s); }
+  char operator[](unsigned int i) const { return i < s_.size() ? s_[i] : 0; }
+
+  unsigned int length() const { return (unsigned int)s_.size(); }
+  const char* c_str() const { return s_.c_str(); }
+  bool reserve(unsigned int n) { s_.reserve(n); return true; }
+
+ private:
+  std::string s_;
+};
+
+// ===== Print / Stream =====
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t n) {
+    size_t w = 0;
+    while (n--) w += write(*buf++);
+    return w;
+  }
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+  size_t write(const char* buf, size_t n) { return write((const uint8_t*)buf, n); }
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t print(const __FlashStringHelper* s) { return write((const char*)s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC);
+  size_t print(unsigned long v, int base = DEC);
+  size_t print(double v, int digits = 2);
+
+  size_t println() { return write("\r\n"); }
+  template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+  template <typename T> size_t println(const T& v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  size_t readBytes(char* buf, size_t n) {
+    size_t got = 0;
+    while (got < n) {
+      int c = read();
+      if (c < 0) break;
+      buf[got++] = (char)c;
+    }
+    return got;
+  }
+};
+
+// 시리얼 포트: 송수신은 현재 HalBackend 로 전달된다
+class HostSerial : public Stream {
+ public:
+  void begin(unsigned long baud) { (void)baud; }
+  void end() {}
+  operator bool() const { return true; }
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buf, size_t n) override;
+  int availableForWrite() override;
+  void flush() override;
+  using Print::write;
+};
+
+extern HostSerial Serial;
+
+// 스케치 진입점 (rs232_botty_2025_1001_02_due.ino)
+void setup();
+void loop();
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,111 @@
+// =======================================================
+// === 명령 디스패치 마이크로벤치마크 (botty_sim --bench-dispatch)
+// === 기존 strcmp 체인(장비 -> 함수)과 dispatch.cpp 의 해시 테이블
+// === 조회를 같은 입력 집합으로 비교한다. 핸들러는 실행하지 않는다.
+// =======================================================
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "Arduino.h"
+#include "../dispatch.h"
+
+struct BenchInput {
+  const char* device;
+  const char* function;
+};
+
+static const BenchInput INPUTS[] = {
+  {"cup", "startdispense"},    {"cup", "stopdispense"},
+  {"ramen", "startdispense"},  {"ramen", "readydispense"},
+  {"ramen", "initdispense"},   {"ramen", "stopdispense"},
+  {"powder", "startdispense"}, {"powder", "stopdispense"},
+  {"cooker", "startcook"},     {"cooker", "stopcook"},
+  {"outlet", "opendoor"},      {"outlet", "closedoor"},
+  {"outlet", "stopoutlet"},
+  {"outlet", "jam"},           {"fryer", "start"},
+};
+static const int INPUT_COUNT = sizeof(INPUTS) / sizeof(INPUTS[0]);
+
+// 변경 전 parseAndDispatch()/handle*Command() 의 비교 순서 그대로 (명령 번호 반환, 없으면 -1)
+static int legacyChain(const char* dev, const char* func) {
+  if (strcmp(dev, "setting") == 0) { return 100; }
+  else if (strcmp(dev, "query") == 0) { return 101; }
+  else if (strcmp(dev, "stats") == 0) { return 102; }
+  else if (strcmp(dev, "cup") == 0) {
+    if (strcmp(func, "startdispense") == 0) return 0;
+    else if (strcmp(func, "stopdispense") == 0) return 1;
+  } else if (strcmp(dev, "ramen") == 0) {
+    if (strcmp(func, "startdispense") == 0) return 2;
+    else if (strcmp(func, "readydispense") == 0) return 3;
+    else if (strcmp(func, "initdispense") == 0) return 4;
+    else if (strcmp(func, "stopdispense") == 0) return 5;
+  } else if (strcmp(dev, "powder") == 0) {
+    if (strcmp(func, "startdispense") == 0) return 6;
+    else if (strcmp(func, "stopdispense") == 0) return 7;
+  } else if (strcmp(dev, "cooker") == 0) {
+    if (strcmp(func, "startcook") == 0) return 8;
+    else if (strcmp(func, "stopcook") == 0) return 9;
+  } else if (strcmp(dev, "outlet") == 0) {
+    if (strcmp(func, "opendoor") == 0) return 10;
+    else if (strcmp(func, "closedoor") == 0) return 11;
+    else if (strcmp(func, "stopoutlet") == 0) return 12;
+  }
+  return -1;
+}
+
+static const CommandSpec* tableLookup(const char* dev, const char* func) {
+  const DeviceSpec* d = findDevice(dev);
+  return d ? findCommand(d, func) : nullptr;
+}
+
+static double nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int runDispatchBench() {
+  const long ROUNDS = 2000000;
+  dispatchBegin();
+
+  // 두 방식이 같은 입력에 대해 같은 결과(성공/실패)를 내는지 먼저 확인
+  for (int i = 0; i < INPUT_COUNT; i++) {
+    bool a = legacyChain(INPUTS[i].device, INPUTS[i].function) >= 0;
+    bool b = tableLookup(INPUTS[i].device, INPUTS[i].function) != nullptr;
+    if (a != b) {
+      fprintf(stderr, "mismatch: %s/%s\n", INPUTS[i].device, INPUTS[i].function);
+      return 1;
+    }
+  }
+
+  volatile long sink = 0;
+  double t0 = nowNs();
+  for (long r = 0; r < ROUNDS; r++) {
+    const BenchInput& in = INPUTS[r % INPUT_COUNT];
+    sink += legacyChain(in.device, in.function);
+  }
+  double t1 = nowNs();
+  for (long r = 0; r < ROUNDS; r++) {
+    const BenchInput& in = INPUTS[r % INPUT_COUNT];
+    sink += (long)(tableLookup(in.device, in.function) != nullptr);
+  }
+  double t2 = nowNs();
+
+  printf("dispatch bench: %ld lookups over %d inputs\n", ROUNDS, INPUT_COUNT);
+  printf("  strcmp chain : %7.2f ns/lookup\n", (t1 - t0) / ROUNDS);
+  printf("  hash table   : %7.2f ns/lookup\n", (t2 - t1) / ROUNDS);
+
+  // 입력별 (마지막 항목일수록 체인이 길어짐)
+  for (int i = 0; i < INPUT_COUNT; i++) {
+    const BenchInput& in = INPUTS[i];
+    double a0 = nowNs();
+    for (long r = 0; r < ROUNDS / 10; r++) sink += legacyChain(in.device, in.function);
+    double a1 = nowNs();
+    for (long r = 0; r < ROUNDS / 10; r++) sink += (long)(tableLookup(in.device, in.function) != nullptr);
+    double a2 = nowNs();
+    printf("  %-7s %-14s chain %6.2f ns  table %6.2f ns\n", in.device, in.function,
+           (a1 - a0) / (ROUNDS / 10), (a2 - a1) / (ROUNDS / 10));
+  }
+  return 0;
+}
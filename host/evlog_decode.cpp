@@ -0,0 +1,130 @@
+// =======================================================
+// === 이벤트 기록기 해독 (botty_sim --decode-evlog FILE|-)
+// === 시리얼 캡처에서 {"device":"evlog","seq":..,"hex":..} 줄만 골라
+// === seq 순으로 정렬(중복 제거)하고 시간축으로 출력한다.
+// === micros() 는 약 71분마다 돌아오므로 앞 기록과의 차이로 이어 붙인다.
+// =======================================================
+
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <ArduinoJson.h>
+#include "Arduino.h"
+#include "../evlog.h"
+#include "../dispatch.h"
+#include "../actuator.h"
+
+static const char* const DEVICE_NAMES[] = { "cup", "ramen", "powder", "cooker", "outlet", "system" };
+
+static int hexNibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static bool parseLine(const char* line, std::map<uint32_t, EvRecord>& out) {
+  if (!strstr(line, "\"evlog\"") || !strstr(line, "\"hex\"")) return false;
+  StaticJsonDocument<768> doc;
+  if (deserializeJson(doc, line)) return false;
+  const char* hex = doc["hex"] | "";
+  uint32_t seq = doc["seq"] | 0UL;
+  size_t len = strlen(hex);
+  for (size_t pos = 0; pos + 16 <= len; pos += 16, seq++) {
+    uint8_t b[8];
+    for (int k = 0; k < 8; k++) {
+      int hi = hexNibble(hex[pos + k * 2]);
+      int lo = hexNibble(hex[pos + k * 2 + 1]);
+      if (hi < 0 || lo < 0) return false;
+      b[k] = (uint8_t)(hi << 4 | lo);
+    }
+    evlogDecode(b, out[seq]);
+  }
+  return true;
+}
+
+static void printTarget(uint8_t arg) {
+  uint8_t act = arg >> 4;
+  printf(" %s %u", act < ACT_COUNT ? ACTUATOR_NAMES[act] : "?", (arg & 0x0F) + 1);
+}
+
+static void printDetail(const EvRecord& r) {
+  switch (r.type) {
+    case EV_BOOT:
+      printf(" reset_cause=%u", r.arg);
+      break;
+    case EV_SETTING:
+      printf(" cup=%u ramen=%u powder=%u cooker=%u outlet=%u",
+             r.value & 7, (r.value >> 3) & 7, (r.value >> 6) & 15, (r.value >> 10) & 7, (r.value >> 13) & 7);
+      break;
+    case EV_CMD: {
+      const CommandSpec* cmd = findCommandByOp(r.arg);
+      uint8_t status = r.value >> 8;
+      if (cmd) printf(" %s/%s", DEVICE_NAMES[cmd->device], cmd->function);
+      else printf(" op=0x%02x", r.arg);
+      printf(" control=%u %s", r.value & 0xFF, status < CMD_STATUS_COUNT ? COMMAND_STATUS_NAMES[status] : "?");
+      break;
+    }
+    case EV_MOTOR_START:
+      printf(" pin=%u %s", r.arg, r.value < ACT_COUNT ? ACTUATOR_NAMES[r.value] : "?");
+      break;
+    case EV_MOTOR_STOP:
+      printf(" pin=%u", r.arg);
+      break;
+    case EV_LIMIT:
+      printf(" pin=%u level=%u", r.arg, r.value);
+      break;
+    case EV_TRIP:
+    case EV_PEAK:
+      printTarget(r.arg);
+      printf(" amp=%u", r.value);
+      break;
+    case EV_TIMEOUT:
+      printTarget(r.arg);
+      printf(" elapsed=%ums", r.value);
+      break;
+    case EV_STALL:
+      printf(" ramen %u speed=%u", r.arg + 1, r.value);
+      break;
+    default:
+      printf(" arg=%u value=%u", r.arg, r.value);
+      break;
+  }
+}
+
+int runEvlogDecode(const char* path) {
+  FILE* f = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+  if (!f) { perror(path); return 1; }
+  std::map<uint32_t, EvRecord> recs;
+  char line[2048];
+  int lines = 0;
+  while (fgets(line, sizeof(line), f)) {
+    if (parseLine(line, recs)) lines++;
+  }
+  if (f != stdin) fclose(f);
+  if (recs.empty()) { fprintf(stderr, "no evlog records found\n"); return 1; }
+  dispatchBegin();
+
+  printf("# %zu records from %d lines (seq %u..%u)\n", recs.size(), lines,
+         recs.begin()->first, recs.rbegin()->first);
+  printf("#      seq        t_ms     +delta_us  event\n");
+  uint64_t t = 0;
+  uint32_t prevUs = 0;
+  uint32_t prevSeq = 0;
+  bool first = true;
+  for (const auto& kv : recs) {
+    const EvRecord& r = kv.second;
+    uint32_t delta = first ? 0 : r.us - prevUs;
+    if (!first && kv.first != prevSeq + 1) printf("# ... %u records missing\n", kv.first - prevSeq - 1);
+    t += delta;
+    printf("%10u %11.3f %13u  %-11s", kv.first, t / 1000.0, delta,
+           r.type < EV_TYPE_COUNT ? EVLOG_TYPE_NAMES[r.type] : "?");
+    printDetail(r);
+    printf("\n");
+    prevUs = r.us;
+    prevSeq = kv.first;
+    first = false;
+  }
+  return 0;
+}
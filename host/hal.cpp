@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include "Arduino.h"
+#include "hal.h"
+
+// =======================================================
+// === Arduino API -> HalBackend 위임
+// =======================================================
+
+static HalBackend* g_backend = nullptr;
+
+void halSetBackend(HalBackend* backend) { g_backend = backend; }
+HalBackend* halBackend() { return g_backend; }
+
+static HalBackend& hal() {
+  if (!g_backend) {
+    fprintf(stderr, "hal: backend not set\n");
+    abort();
+  }
+  return *g_backend;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) { hal().pinMode(pin, mode); }
+void digitalWrite(uint8_t pin, uint8_t val) { hal().digitalWrite(pin, val); }
+int digitalRead(uint8_t pin) { return hal().digitalRead(pin); }
+int analogRead(uint8_t pin) { return hal().analogRead(pin); }
+void analogWrite(uint8_t pin, int val) { hal().analogWrite(pin, val); }
+void analogReadResolution(int bits) { (void)bits; }
+void analogWriteResolution(int bits) { (void)bits; }
+
+unsigned long micros() { return hal().micros(); }
+unsigned long millis() { return hal().micros() / 1000UL; }
+void delay(unsigned long ms) { hal().delayMicros((uint32_t)(ms * 1000UL)); }
+void delayMicroseconds(unsigned int us) { hal().delayMicros(us); }
+
+void noInterrupts() { hal().setInterruptsEnabled(false); }
+void interrupts() { hal().setInterruptsEnabled(true); }
+uint32_t __get_PRIMASK() { return hal().interruptsEnabled() ? 0 : 1; }
+void __set_PRIMASK(uint32_t primask) { hal().setInterruptsEnabled((primask & 1) == 0); }
+void __disable_irq() { hal().setInterruptsEnabled(false); }
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) { hal().attachInterrupt(pin, isr, mode); }
+void detachInterrupt(uint8_t pin) { hal().detachInterrupt(pin); }
+
+// ===== Print =====
+size_t Print::print(long v, int base) {
+  if (v < 0 && base == DEC) {
+    size_t n = write((uint8_t)'-');
+    return n + print((unsigned long)(-v), base);
+  }
+  return print((unsigned long)v, base);
+}
+
+size_t Print::print(unsigned long v, int base) {
+  char buf[8 * sizeof(long) + 1];
+  char* p = &buf[sizeof(buf) - 1];
+  *p = '\0';
+  if (base < 2) base = 10;
+  do {
+    unsigned long d = v % base;
+    *--p = (char)(d < 10 ? '0' + d : 'A' + d - 10);
+    v /= base;
+  } while (v);
+  return write(p);
+}
+
+size_t Print::print(double v, int digits) {
+  char fmt[16], buf[64];
+  snprintf(fmt, sizeof(fmt), "%%.%df", digits < 0 ? 0 : digits);
+  snprintf(buf, sizeof(buf), fmt, v);
+  return write(buf);
+}
+
+// ===== Serial =====
+HostSerial Serial;
+
+int HostSerial::available() { return hal().serialAvailable(); }
+int HostSerial::read() { return hal().serialRead(); }
+int HostSerial::peek() { return hal().serialPeek(); }
+size_t HostSerial::write(uint8_t c) { return hal().serialWrite(&c, 1); }
+size_t HostSerial::write(const uint8_t* buf, size_t n) { return hal().serialWrite(buf, n); }
+int HostSerial::availableForWrite() { return hal().serialAvailableForWrite(); }
+void HostSerial::flush() {}
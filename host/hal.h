@@ -0,0 +1,49 @@
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =======================================================
+// === 호스트 HAL (Hardware Abstraction Layer)
+// === Arduino.h 대체 함수들은 모두 현재 등록된 HalBackend 로
+// === 위임된다. 시뮬레이터(SimBoard) 외의 백엔드(로그 재생,
+// === 실장비 브리지 등)도 이 인터페이스만 구현하면 교체 가능하다.
+// =======================================================
+
+class HalBackend {
+ public:
+  virtual ~HalBackend() {}
+
+  // --- 핀 I/O ---
+  virtual void pinMode(uint8_t pin, uint8_t mode) = 0;
+  virtual void digitalWrite(uint8_t pin, uint8_t val) = 0;
+  virtual int digitalRead(uint8_t pin) = 0;
+  virtual void analogWrite(uint8_t pin, int val) { (void)pin; (void)val; }
+
+  // --- ADC ---
+  virtual int analogRead(uint8_t pin) = 0;
+
+  // --- 시계 (마이크로초 단위, 32bit 랩어라운드) ---
+  virtual uint32_t micros() = 0;
+  virtual void delayMicros(uint32_t us) = 0;
+
+  // --- 시리얼 포트 ---
+  virtual int serialAvailable() = 0;
+  virtual int serialRead() = 0;
+  virtual int serialPeek() = 0;
+  virtual size_t serialWrite(const uint8_t* buf, size_t n) = 0;
+  virtual int serialAvailableForWrite() { return 64; }
+
+  // --- 인터럽트 ---
+  virtual void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) = 0;
+  virtual void detachInterrupt(uint8_t pin) = 0;
+  virtual void setInterruptsEnabled(bool en) = 0;
+  virtual bool interruptsEnabled() const = 0;
+};
+
+// 백엔드 등록 (main 에서 setup() 호출 전에 지정)
+void halSetBackend(HalBackend* backend);
+HalBackend* halBackend();
+
+#endif // HOST_HAL_H
@@ -0,0 +1,332 @@
+// =======================================================
+// === botty_sim : 펌웨어 setup()/loop() 를 SimBoard 위에서 실행
+// ===
+// === 빌드 (저장소 루트에서, ArduinoJson 6.x 소스 경로 지정):
+// ===   g++ -std=gnu++17 -O2 -I host -I <ArduinoJson>/src
+// ===       host/*.cpp *.cpp -o botty_sim
+// ===
+// === 사용:
+// ===   ./botty_sim --rig ramen=1 --script order.txt --run-ms 8000
+// ===   스크립트 한 줄 = "<시각ms> <JSON 명령>" ('#' 주석)
+// ===   "<시각ms> bin <OP> <PAYLOAD...>" (16진수 바이트) 는 바이너리 프레임으로
+// ===   CRC 를 붙여 전송하고, 출력의 바이너리 프레임은 "#BIN ..." 줄로 표시한다.
+// ===   --script 가 없으면 stdin 으로 들어온 줄을 즉시 전달한다.
+// ===   종료 시 loop() 1회 실행 시간 통계를 stderr 로 출력한다.
+// ===   --ramen-jam N : 면 리프트가 엔코더 N 위치에서 걸림 (정체 감지 시험)
+// ===   --adc-wave A0:sine,512,200,50,8 : 핀에 합성 파형 주입
+// ===       (모양 sine|square|step, 오프셋, 진폭, 주파수Hz, 잡음, [step 시각ms])
+// ===   --adc-dump MS : MS 마다 파형 핀의 "#ADC t= in= raw= filt=" 출력 (필터 확인)
+// ===   ./botty_sim --bench-dispatch : 명령 디스패치 마이크로벤치마크
+// ===   ./botty_sim --decode-evlog FILE|- : evlog dump 캡처를 시간축으로 해독
+// =======================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "hal.h"
+#include "sim_board.h"
+#include "sim_mech.h"
+#include "../config.h"
+#include "../binproto.h"
+#include "../adc.h"
+
+struct ScriptLine {
+  uint32_t atMs;
+  std::string text;
+};
+
+int runDispatchBench();   // bench_dispatch.cpp
+int runEvlogDecode(const char* path);   // evlog_decode.cpp
+
+static uint64_t monotonicNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void usage() {
+  fprintf(stderr,
+          "usage: botty_sim [--rig cup=N,ramen=N,powder=N,cooker=N,outlet=N]\n"
+          "                 [--script FILE] [--run-ms MS] [--virtual TICK_US]\n"
+          "                 [--baud BAUD|0] [--trace] [--ramen-jam COUNTS]\n"
+          "                 [--adc-wave PIN:SHAPE,OFS,AMP,HZ,NOISE[,AT_MS]]... [--adc-dump MS]\n"
+          "       botty_sim --bench-dispatch\n"
+          "       botty_sim --decode-evlog FILE|-\n");
+}
+
+static bool parseRig(const char* spec, uint8_t rig[5]) {
+  static const char* names[5] = {"cup", "ramen", "powder", "cooker", "outlet"};
+  std::string s(spec);
+  size_t pos = 0;
+  while (pos < s.size()) {
+    size_t end = s.find(',', pos);
+    if (end == std::string::npos) end = s.size();
+    std::string item = s.substr(pos, end - pos);
+    size_t eq = item.find('=');
+    if (eq == std::string::npos) return false;
+    std::string key = item.substr(0, eq);
+    int n = atoi(item.c_str() + eq + 1);
+    bool found = false;
+    for (int k = 0; k < 5; k++) {
+      if (key == names[k]) { rig[k] = (uint8_t)n; found = true; }
+    }
+    if (!found) return false;
+    pos = end + 1;
+  }
+  return true;
+}
+
+static bool loadScript(const char* path, std::vector<ScriptLine>& out) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  char buf[1024];
+  while (fgets(buf, sizeof(buf), f)) {
+    char* p = buf;
+    while (*p == ' ' || *p == '\t') p++;
+    size_t len = strlen(p);
+    while (len && (p[len - 1] == '\n' || p[len - 1] == '\r')) p[--len] = '\0';
+    if (len == 0 || *p == '#') continue;
+    char* rest = p;
+    uint32_t at = (uint32_t)strtoul(p, &rest, 10);
+    if (rest == p) at = 0;
+    while (*rest == ' ' || *rest == '\t') rest++;
+    out.push_back({at, rest});
+  }
+  fclose(f);
+  std::stable_sort(out.begin(), out.end(),
+                   [](const ScriptLine& a, const ScriptLine& b) { return a.atMs < b.atMs; });
+  return true;
+}
+
+// "bin 10 01" -> SYNC/LEN/OP/PAYLOAD/CRC 프레임
+static void sendBinaryLine(SimBoard& board, const char* hex) {
+  uint8_t body[BIN_MAX_PAYLOAD + 1];
+  size_t n = 0;
+  char* end;
+  for (;;) {
+    unsigned long v = strtoul(hex, &end, 16);
+    if (end == hex || n >= sizeof(body)) break;
+    body[n++] = (uint8_t)v;
+    hex = end;
+  }
+  if (n == 0) return;
+  uint8_t frame[BIN_MAX_PAYLOAD + BIN_OVERHEAD];
+  uint8_t len = (uint8_t)(n - 1);
+  frame[0] = BIN_SYNC;
+  frame[1] = len;
+  memcpy(&frame[2], body, n);
+  uint16_t crc = binCrc16(&frame[1], (uint16_t)(len + 2));
+  frame[3 + len] = (uint8_t)(crc & 0xFF);
+  frame[4 + len] = (uint8_t)(crc >> 8);
+  board.hostSendRaw(frame, len + BIN_OVERHEAD);
+}
+
+static void sendScriptLine(SimBoard& board, const std::string& text) {
+  if (text.compare(0, 4, "bin ") == 0) sendBinaryLine(board, text.c_str() + 4);
+  else board.hostSend(text.c_str());
+}
+
+// 출력 스트림에서 바이너리 프레임을 골라 16진수로 표시 (텍스트 줄은 그대로)
+static void decodeOutput(const uint8_t* data, size_t n) {
+  static std::vector<uint8_t> rec;
+  static bool lineStart = true;
+  static bool inFrame = false;
+  for (size_t i = 0; i < n; i++) {
+    uint8_t c = data[i];
+    if (lineStart && !inFrame && c == BIN_SYNC) inFrame = true;
+    lineStart = false;
+    if (!inFrame) {
+      fputc(c, stdout);
+      if (c == '\n') lineStart = true;
+      continue;
+    }
+    rec.push_back(c);
+    if (rec.size() >= 2 && rec.size() == (size_t)BIN_OVERHEAD + rec[1]) {
+      uint8_t len = rec[1];
+      uint16_t crc = (uint16_t)(rec[3 + len] | (rec[4 + len] << 8));
+      printf("#BIN op=0x%02X len=%u crc=%s", rec[2], len,
+             binCrc16(&rec[1], (uint16_t)(len + 2)) == crc ? "ok" : "BAD");
+      for (uint8_t k = 0; k < len; k++) printf(" %02X", rec[3 + k]);
+      printf("\n");
+      rec.clear();
+      inFrame = false;
+      lineStart = true;
+    }
+  }
+}
+
+// stdin 에서 완성된 줄을 논블로킹으로 읽는다. EOF 면 false
+static bool pollStdin(SimBoard& board, std::string& partial) {
+  struct pollfd pfd = {0, POLLIN, 0};
+  while (poll(&pfd, 1, 0) > 0) {
+    char buf[256];
+    ssize_t n = read(0, buf, sizeof(buf));
+    if (n <= 0) return false;
+    for (ssize_t i = 0; i < n; i++) {
+      if (buf[i] == '\n') {
+        board.hostSend(partial.c_str());
+        partial.clear();
+      } else if (buf[i] != '\r') {
+        partial += buf[i];
+      }
+    }
+  }
+  return true;
+}
+
+static void printLoopStats(std::vector<uint32_t>& ns, uint64_t total) {
+  if (ns.empty()) return;
+  std::sort(ns.begin(), ns.end());
+  uint64_t sum = 0;
+  for (size_t i = 0; i < ns.size(); i++) sum += ns[i];
+  fprintf(stderr,
+          "loop(): %llu iterations (%zu sampled)  mean %.2f us  p50 %.2f us  p99 %.2f us  max %.2f us\n",
+          (unsigned long long)total, ns.size(), sum / 1000.0 / ns.size(),
+          ns[ns.size() / 2] / 1000.0, ns[(ns.size() * 99) / 100] / 1000.0, ns.back() / 1000.0);
+}
+
+struct WaveArg {
+  uint8_t pin;
+  AnalogWave wave;
+};
+
+// "A0:sine,512,200,50,8" 형식
+static bool parseWave(const char* spec, WaveArg& out) {
+  char shape[16] = {0};
+  unsigned pinNum = 0;
+  float ofs = 0, amp = 0, hz = 0;
+  unsigned noise = 0, atMs = 0;
+  int n = sscanf(spec, "A%u:%15[a-z],%f,%f,%f,%u,%u", &pinNum, shape, &ofs, &amp, &hz, &noise, &atMs);
+  if (n < 6 || pinNum > 11) return false;
+  out.pin = (uint8_t)(A0 + pinNum);
+  if (!strcmp(shape, "sine")) out.wave.shape = AnalogWave::SINE;
+  else if (!strcmp(shape, "square")) out.wave.shape = AnalogWave::SQUARE;
+  else if (!strcmp(shape, "step")) out.wave.shape = AnalogWave::STEP;
+  else return false;
+  out.wave.offset = ofs;
+  out.wave.amplitude = amp;
+  out.wave.freqHz = hz;
+  out.wave.noise = noise;
+  out.wave.atMs = atMs;
+  return true;
+}
+
+int main(int argc, char** argv) {
+  uint8_t rig[5] = {0, 0, 0, 0, 0};
+  const char* scriptPath = nullptr;
+  long runMs = -1;
+  long tickUs = -1;
+  long baud = 115200;
+  bool trace = false;
+  long ramenJam = -1;
+  std::vector<WaveArg> waves;
+  long adcDumpMs = 0;
+
+  for (int a = 1; a < argc; a++) {
+    if (!strcmp(argv[a], "--rig") && a + 1 < argc) {
+      if (!parseRig(argv[++a], rig)) { usage(); return 2; }
+    } else if (!strcmp(argv[a], "--script") && a + 1 < argc) {
+      scriptPath = argv[++a];
+    } else if (!strcmp(argv[a], "--run-ms") && a + 1 < argc) {
+      runMs = atol(argv[++a]);
+    } else if (!strcmp(argv[a], "--virtual") && a + 1 < argc) {
+      tickUs = atol(argv[++a]);
+    } else if (!strcmp(argv[a], "--baud") && a + 1 < argc) {
+      baud = atol(argv[++a]);
+    } else if (!strcmp(argv[a], "--trace")) {
+      trace = true;
+    } else if (!strcmp(argv[a], "--ramen-jam") && a + 1 < argc) {
+      ramenJam = atol(argv[++a]);
+    } else if (!strcmp(argv[a], "--adc-wave") && a + 1 < argc) {
+      WaveArg w;
+      if (!parseWave(argv[++a], w)) { usage(); return 2; }
+      waves.push_back(w);
+    } else if (!strcmp(argv[a], "--adc-dump") && a + 1 < argc) {
+      adcDumpMs = atol(argv[++a]);
+    } else if (!strcmp(argv[a], "--bench-dispatch")) {
+      SimBoard bench(SimBoard::CLOCK_VIRTUAL);
+      halSetBackend(&bench);
+      return runDispatchBench();
+    } else if (!strcmp(argv[a], "--decode-evlog") && a + 1 < argc) {
+      SimBoard decode(SimBoard::CLOCK_VIRTUAL);
+      halSetBackend(&decode);
+      return runEvlogDecode(argv[++a]);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+
+  std::vector<ScriptLine> script;
+  if (scriptPath && !loadScript(scriptPath, script)) {
+    fprintf(stderr, "cannot open script %s\n", scriptPath);
+    return 1;
+  }
+
+  SimParams params;
+  params.ramenJamCounts = (int32_t)ramenJam;
+  SimBoard board(tickUs > 0 ? SimBoard::CLOCK_VIRTUAL : SimBoard::CLOCK_REAL);
+  board.setBaud((uint32_t)baud);
+  board.setTrace(trace);
+  board.setOutputSink(decodeOutput);
+  for (uint8_t i = 0; i < rig[0] && i < MAX_CUP; i++) board.addMechanism(new CupMech(i, params));
+  for (uint8_t i = 0; i < rig[1] && i < MAX_RAMEN; i++) board.addMechanism(new RamenMech(i, params));
+  for (uint8_t i = 0; i < rig[2] && i < MAX_POWDER; i++) board.addMechanism(new PowderMech(i, params));
+  for (uint8_t i = 0; i < rig[3] && i < MAX_COOKER; i++) board.addMechanism(new CookerMech(i, params));
+  for (uint8_t i = 0; i < rig[4] && i < MAX_OUTLET; i++) board.addMechanism(new OutletMech(i, params));
+  board.addMechanism(new DoorMech(params));
+  for (const WaveArg& w : waves) board.setAnalogWave(w.pin, w.wave);
+  halSetBackend(&board);
+
+  setup();
+
+  if (runMs < 0 && scriptPath) runMs = (script.empty() ? 0 : script.back().atMs) + 2000;
+  size_t next = 0;
+  bool stdinOpen = (scriptPath == nullptr);
+  std::string partial;
+  std::vector<uint32_t> samples;
+  samples.reserve(1 << 20);
+  uint64_t iterations = 0;
+  uint64_t nextDumpMs = 0;
+
+  for (;;) {
+    uint64_t nowMs = board.nowUs() / 1000ULL;
+    if (runMs >= 0 && nowMs >= (uint64_t)runMs) break;
+    if (adcDumpMs > 0 && nowMs >= nextDumpMs) {
+      nextDumpMs = nowMs + (uint64_t)adcDumpMs;
+      for (const WaveArg& w : waves) {
+        printf("#ADC t=%llu A%u in=%d raw=%d filt=%d\n", (unsigned long long)nowMs, (unsigned)(w.pin - A0),
+               board.analogWaveValue(w.pin), adcReadRaw(w.pin), adcRead(w.pin));
+      }
+    }
+    while (next < script.size() && script[next].atMs <= nowMs) {
+      sendScriptLine(board, script[next].text);
+      next++;
+    }
+    if (stdinOpen && !pollStdin(board, partial)) {
+      stdinOpen = false;
+      if (runMs < 0) runMs = (long)nowMs + 2000;
+    }
+
+    uint64_t t0 = monotonicNs();
+    loop();
+    uint64_t dt = monotonicNs() - t0;
+    if (samples.size() < samples.capacity()) samples.push_back((uint32_t)std::min<uint64_t>(dt, 0xFFFFFFFFu));
+    iterations++;
+
+    if (tickUs > 0) board.advance((uint32_t)tickUs);
+    else micros();  // 실시간 모드: 기구 모델을 현재 시각까지 적분
+  }
+
+  fflush(stdout);
+  printLoopStats(samples, iterations);
+  return 0;
+}
@@ -0,0 +1,283 @@
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "sim_board.h"
+
+static uint64_t monotonicNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+SimBoard::SimBoard(ClockMode mode) : mode_(mode) {
+  realStartNs_ = monotonicNs();
+}
+
+SimBoard::~SimBoard() {
+  for (size_t i = 0; i < mechs_.size(); i++) delete mechs_[i];
+}
+
+void SimBoard::addMechanism(Mechanism* m) {
+  mechs_.push_back(m);
+  m->begin(*this);
+}
+
+// =======================================================
+// === 시계 / 기구 모델 적분
+// =======================================================
+
+uint64_t SimBoard::readClock() {
+  if (mode_ == CLOCK_VIRTUAL) return nowUs_;
+  return (monotonicNs() - realStartNs_) / 1000ULL;
+}
+
+void SimBoard::stepTo(uint64_t t) {
+  if (stepping_) return;  // ISR 안에서의 재진입 방지
+  stepping_ = true;
+  while (stepUs_ < t) {
+    uint32_t dt = (t - stepUs_ > STEP_US) ? STEP_US : (uint32_t)(t - stepUs_);
+    stepUs_ += dt;
+    for (size_t i = 0; i < mechs_.size(); i++) mechs_[i]->step(*this, dt);
+  }
+  stepping_ = false;
+}
+
+void SimBoard::sync() {
+  uint64_t t = readClock();
+  if (t > nowUs_) nowUs_ = t;
+  stepTo(nowUs_);
+  drainTx(nowUs_);
+}
+
+void SimBoard::advance(uint32_t us) {
+  nowUs_ += us;
+  stepTo(nowUs_);
+  drainTx(nowUs_);
+}
+
+uint32_t SimBoard::micros() {
+  sync();
+  return (uint32_t)nowUs_;
+}
+
+void SimBoard::delayMicros(uint32_t us) {
+  uint64_t until = nowUs_ + us;
+  if (mode_ == CLOCK_VIRTUAL) {
+    advance(us);
+    return;
+  }
+  while (nowUs_ < until) sync();
+}
+
+uint32_t SimBoard::noise(uint32_t amplitude) {
+  rng_ ^= rng_ << 13;
+  rng_ ^= rng_ >> 17;
+  rng_ ^= rng_ << 5;
+  return amplitude ? rng_ % (2 * amplitude + 1) : 0;
+}
+
+// =======================================================
+// === 핀 I/O
+// =======================================================
+
+void SimBoard::pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= NUM_DIGITAL_PINS) return;
+  pins_[pin].mode = mode;
+}
+
+void SimBoard::digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin >= NUM_DIGITAL_PINS) return;
+  sync();
+  Pin& p = pins_[pin];
+  uint8_t v = val ? HIGH : LOW;
+  if (trace_ && (p.out != v || p.pwm >= 0)) {
+    fprintf(stderr, "[%10.3f ms] D%-2u %s\n", nowUs_ / 1000.0, pin, v ? "HIGH" : "LOW");
+  }
+  p.out = v;
+  p.pwm = -1;
+}
+
+void SimBoard::analogWrite(uint8_t pin, int val) {
+  if (pin >= NUM_DIGITAL_PINS) return;
+  sync();
+  Pin& p = pins_[pin];
+  if (trace_ && p.pwm != val) {
+    fprintf(stderr, "[%10.3f ms] D%-2u PWM %d\n", nowUs_ / 1000.0, pin, val);
+  }
+  p.pwm = val;
+  p.out = val > 0 ? HIGH : LOW;
+}
+
+int SimBoard::digitalRead(uint8_t pin) {
+  if (pin >= NUM_DIGITAL_PINS) return LOW;
+  sync();
+  const Pin& p = pins_[pin];
+  if (p.mode == OUTPUT) return p.out;
+  if (p.in >= 0) return p.in;
+  return p.mode == INPUT_PULLUP ? HIGH : LOW;
+}
+
+bool SimBoard::outputHigh(uint8_t pin) const {
+  return pin < NUM_DIGITAL_PINS && pins_[pin].mode == OUTPUT && pins_[pin].out == HIGH;
+}
+
+int SimBoard::pwmDuty(uint8_t pin) const {
+  if (!outputHigh(pin)) return 0;
+  return pins_[pin].pwm >= 0 ? pins_[pin].pwm : 255;
+}
+
+void SimBoard::setInput(uint8_t pin, int level) {
+  if (pin >= NUM_DIGITAL_PINS) return;
+  Pin& p = pins_[pin];
+  int old = (p.in >= 0) ? p.in : (p.mode == INPUT_PULLUP ? HIGH : LOW);
+  p.in = level ? HIGH : LOW;
+  if (p.mode == OUTPUT || old == p.in || !p.isr) return;
+  if (p.isrMode == CHANGE || (p.isrMode == RISING && p.in == HIGH) || (p.isrMode == FALLING && p.in == LOW)) {
+    fireIsr(pin);
+  }
+}
+
+void SimBoard::setAnalog(uint8_t pin, int value) {
+  uint8_t ch = pin >= A0 ? pin - A0 : pin;
+  if (ch >= 16) return;
+  if (value < 0) value = 0;
+  if (value > 1023) value = 1023;
+  analog_[ch] = value;
+}
+
+int SimBoard::analogRead(uint8_t pin) {
+  sync();
+  uint8_t ch = pin >= A0 ? pin - A0 : pin;
+  if (ch >= 16) return 0;
+  if (!waveOn_[ch]) return analog_[ch];
+
+  int v = analogWaveValue(pin) + (int)noise(waves_[ch].noise) - (int)waves_[ch].noise;
+  if (v < 0) v = 0;
+  if (v > 1023) v = 1023;
+  return v;
+}
+
+void SimBoard::setAnalogWave(uint8_t pin, const AnalogWave& w) {
+  uint8_t ch = pin >= A0 ? pin - A0 : pin;
+  if (ch >= 16) return;
+  waves_[ch] = w;
+  waveOn_[ch] = true;
+}
+
+int SimBoard::analogWaveValue(uint8_t pin) {
+  uint8_t ch = pin >= A0 ? pin - A0 : pin;
+  if (ch >= 16 || !waveOn_[ch]) return -1;
+  const AnalogWave& w = waves_[ch];
+  double t = nowUs_ / 1e6;
+  double phase = 2.0 * M_PI * w.freqHz * t;
+  double v = w.offset;
+  switch (w.shape) {
+    case AnalogWave::SINE:   v += w.amplitude * sin(phase); break;
+    case AnalogWave::SQUARE: v += (sin(phase) >= 0) ? w.amplitude : -w.amplitude; break;
+    case AnalogWave::STEP:   if (nowUs_ >= (uint64_t)w.atMs * 1000ULL) v += w.amplitude; break;
+  }
+  return (int)lround(v);
+}
+
+// =======================================================
+// === 인터럽트
+// =======================================================
+
+void SimBoard::attachInterrupt(uint8_t pin, void (*isr)(void), int mode) {
+  if (pin >= NUM_DIGITAL_PINS) return;
+  pins_[pin].isr = isr;
+  pins_[pin].isrMode = mode;
+}
+
+void SimBoard::detachInterrupt(uint8_t pin) {
+  if (pin >= NUM_DIGITAL_PINS) return;
+  pins_[pin].isr = nullptr;
+  pins_[pin].pending = false;
+}
+
+void SimBoard::fireIsr(uint8_t pin) {
+  Pin& p = pins_[pin];
+  if (!irqEnabled_ || inIsr_) {
+    p.pending = true;
+    return;
+  }
+  inIsr_ = true;
+  p.isr();
+  inIsr_ = false;
+}
+
+void SimBoard::runPending() {
+  for (uint8_t pin = 0; pin < NUM_DIGITAL_PINS; pin++) {
+    if (pins_[pin].pending && pins_[pin].isr) {
+      pins_[pin].pending = false;
+      fireIsr(pin);
+    }
+  }
+}
+
+void SimBoard::setInterruptsEnabled(bool en) {
+  irqEnabled_ = en;
+  if (en && !inIsr_) runPending();
+}
+
+// =======================================================
+// === 시리얼
+// =======================================================
+
+void SimBoard::hostSend(const char* line) {
+  while (*line) rx_.push_back((uint8_t)*line++);
+  rx_.push_back('\n');
+}
+
+void SimBoard::hostSendRaw(const uint8_t* data, size_t n) {
+  rx_.insert(rx_.end(), data, data + n);
+}
+
+int SimBoard::serialAvailable() { return (int)rx_.size(); }
+
+int SimBoard::serialRead() {
+  if (rx_.empty()) return -1;
+  uint8_t c = rx_.front();
+  rx_.pop_front();
+  return c;
+}
+
+int SimBoard::serialPeek() { return rx_.empty() ? -1 : rx_.front(); }
+
+void SimBoard::drainTx(uint64_t t) {
+  if (baud_ == 0) { txFifo_ = 0; txDrainUs_ = t; return; }
+  uint64_t byteUs = 10000000ULL / baud_;  // 8N1 = 10bit
+  if (txFifo_ == 0 || byteUs == 0) { txDrainUs_ = t; return; }
+  uint64_t sent = (t - txDrainUs_) / byteUs;
+  if (sent >= txFifo_) { txFifo_ = 0; txDrainUs_ = t; return; }
+  txFifo_ -= (uint32_t)sent;
+  txDrainUs_ += sent * byteUs;
+}
+
+int SimBoard::serialAvailableForWrite() {
+  sync();
+  if (baud_ == 0) return TX_FIFO_SIZE;
+  return TX_FIFO_SIZE - (int)txFifo_;
+}
+
+size_t SimBoard::serialWrite(const uint8_t* buf, size_t n) {
+  if (sink_) sink_(buf, n);
+  else fwrite(buf, 1, n, stdout);
+  if (baud_ == 0) return n;
+  sync();
+  size_t left = n;
+  while (left > 0) {
+    uint32_t space = TX_FIFO_SIZE - txFifo_;
+    if (space == 0) {
+      // FIFO 가 가득 참: 실제 UART 처럼 1바이트 빠질 때까지 대기
+      uint64_t byteUs = 10000000ULL / baud_;
+      if (mode_ == CLOCK_VIRTUAL) advance((uint32_t)byteUs);
+      else sync();
+      continue;
+    }
+    uint32_t chunk = left < space ? (uint32_t)left : space;
+    txFifo_ += chunk;
+    left -= chunk;
+  }
+  return n;
+}
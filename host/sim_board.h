@@ -0,0 +1,127 @@
+#ifndef HOST_SIM_BOARD_H
+#define HOST_SIM_BOARD_H
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+#include "Arduino.h"
+#include "hal.h"
+
+// =======================================================
+// === SimBoard : 리눅스용 시뮬레이션 HalBackend
+// === - 핀 출력은 래치되고, 입력은 기구 모델(Mechanism)이 구동
+// === - 시계는 실시간(REAL) 또는 가상(VIRTUAL) 모드
+// === - 시리얼 TX 는 보레이트 기준 128바이트 FIFO 로 모델링
+// ===   (가득 차면 실제 UART 처럼 write 가 블로킹됨)
+// =======================================================
+
+class SimBoard;
+
+// 기구 모델 인터페이스: step() 에서 출력 핀을 보고 입력/ADC 를 갱신
+class Mechanism {
+ public:
+  virtual ~Mechanism() {}
+  virtual void begin(SimBoard& b) { (void)b; }
+  virtual void step(SimBoard& b, uint32_t dtUs) = 0;
+};
+
+// 합성 아날로그 파형 (ADC 필터 시험용). 설정된 핀은 기구 모델 값 대신
+// 읽는 시각의 파형 값 + 읽을 때마다 새로 뽑은 균등 잡음을 돌려준다.
+struct AnalogWave {
+  enum Shape { SINE, SQUARE, STEP } shape = SINE;
+  float offset = 512;      // ADC count (10bit)
+  float amplitude = 0;     // SINE/SQUARE: 진폭, STEP: atMs 이후 더해지는 값
+  float freqHz = 0;
+  uint32_t noise = 0;      // +-noise
+  uint32_t atMs = 0;       // STEP 시각
+};
+
+class SimBoard : public HalBackend {
+ public:
+  enum ClockMode { CLOCK_REAL, CLOCK_VIRTUAL };
+
+  static const uint32_t STEP_US = 100;          // 기구 모델 최대 적분 간격
+  static const uint16_t TX_FIFO_SIZE = 128;     // Due UART 링버퍼 크기
+
+  explicit SimBoard(ClockMode mode);
+  ~SimBoard();
+
+  void addMechanism(Mechanism* m);   // 소유권 이전
+  void setBaud(uint32_t baud) { baud_ = baud; }
+  void setTrace(bool on) { trace_ = on; }
+
+  // --- 시뮬레이터 측 API (Mechanism / main 에서 사용) ---
+  bool outputHigh(uint8_t pin) const;
+  int pwmDuty(uint8_t pin) const;                // analogWrite 값 (미사용시 HIGH=255)
+  void setInput(uint8_t pin, int level);         // 에지 발생 시 ISR 호출
+  void setAnalog(uint8_t pin, int value);
+  void setAnalogWave(uint8_t pin, const AnalogWave& w);
+  int analogWaveValue(uint8_t pin);              // 잡음 없는 파형 값 (-1: 파형 없음)
+  uint64_t nowUs() const { return nowUs_; }
+  void advance(uint32_t us);                     // VIRTUAL 모드 시간 진행
+  void hostSend(const char* line);               // 호스트 -> 펌웨어 수신 큐
+  void hostSendRaw(const uint8_t* data, size_t n);
+  // 펌웨어 -> 호스트 출력 처리기 (기본: stdout 에 그대로 기록)
+  void setOutputSink(void (*sink)(const uint8_t* data, size_t n)) { sink_ = sink; }
+  uint32_t noise(uint32_t amplitude);            // 결정적 의사 난수 (ADC 잡음)
+
+  // --- HalBackend ---
+  void pinMode(uint8_t pin, uint8_t mode) override;
+  void digitalWrite(uint8_t pin, uint8_t val) override;
+  int digitalRead(uint8_t pin) override;
+  void analogWrite(uint8_t pin, int val) override;
+  int analogRead(uint8_t pin) override;
+  uint32_t micros() override;
+  void delayMicros(uint32_t us) override;
+  int serialAvailable() override;
+  int serialRead() override;
+  int serialPeek() override;
+  size_t serialWrite(const uint8_t* buf, size_t n) override;
+  int serialAvailableForWrite() override;
+  void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) override;
+  void detachInterrupt(uint8_t pin) override;
+  void setInterruptsEnabled(bool en) override;
+  bool interruptsEnabled() const override { return irqEnabled_; }
+
+ private:
+  struct Pin {
+    uint8_t mode = INPUT;
+    uint8_t out = LOW;
+    int8_t in = -1;          // -1: 구동되지 않음 (풀업/플로팅)
+    int pwm = -1;            // analogWrite 듀티 (-1: 디지털 출력)
+    void (*isr)(void) = nullptr;
+    int isrMode = 0;
+    bool pending = false;
+  };
+
+  uint64_t readClock();
+  void sync();
+  void stepTo(uint64_t t);
+  void drainTx(uint64_t t);
+  void fireIsr(uint8_t pin);
+  void runPending();
+
+  ClockMode mode_;
+  uint64_t nowUs_ = 0;
+  uint64_t stepUs_ = 0;            // 기구 모델이 적분된 시각
+  uint64_t realStartNs_ = 0;
+  bool stepping_ = false;
+  bool irqEnabled_ = true;
+  bool inIsr_ = false;
+  bool trace_ = false;
+
+  Pin pins_[NUM_DIGITAL_PINS];
+  int analog_[16] = {0};
+  AnalogWave waves_[16];
+  bool waveOn_[16] = {false};
+  std::vector<Mechanism*> mechs_;
+
+  std::deque<uint8_t> rx_;
+  void (*sink_)(const uint8_t* data, size_t n) = nullptr;
+  uint32_t baud_ = 115200;
+  uint32_t txFifo_ = 0;            // 아직 선로로 나가지 않은 바이트
+  uint64_t txDrainUs_ = 0;
+  uint32_t rng_ = 0x2545F491u;
+};
+
+#endif // HOST_SIM_BOARD_H
@@ -0,0 +1,166 @@
+#include "sim_mech.h"
+#include "../config.h"
+
+static float clamp01(float v) { return v < 0 ? 0 : (v > 1 ? 1 : v); }
+
+// drive: 평균 인가 전압 비율 (PWM duty / 255). 돌입 전류는 drive 와 현재 속도의 차이에 비례
+void MotorModel::step(const SimParams& p, float drive, bool stalled, uint32_t dtUs) {
+  float tau = p.inrushMs * 1000.0f;
+  float target = stalled ? 0.0f : drive;
+  float k = tau > 0 ? dtUs / tau : 1.0f;
+  if (k > 1) k = 1;
+  speed += (target - speed) * k;
+  float slip = drive > speed ? drive - speed : 0.0f;
+  if (drive <= 0) amp = (float)p.ampIdle;
+  else if (stalled) amp = p.ampIdle + (p.ampStall - p.ampIdle) * drive;
+  else amp = p.ampIdle + (p.ampRun - p.ampIdle) * speed + (p.ampStall - p.ampRun) * slip;
+}
+
+static float drive(SimBoard& b, uint8_t pin) {
+  return b.pwmDuty(pin) / 255.0f;
+}
+
+static int adc(SimBoard& b, const SimParams& p, float v) {
+  return (int)v + (int)b.noise(p.adcNoise) - p.adcNoise;
+}
+
+// ===== Cup =====
+void CupMech::begin(SimBoard& b) {
+  b.setInput(CUP_ROT_IN[i_], HIGH);
+  b.setInput(CUP_DISP_IN[i_], LOW);
+  b.setInput(CUP_STOCK_IN[i_], stock_ > 0 ? HIGH : LOW);
+}
+
+void CupMech::step(SimBoard& b, uint32_t dtUs) {
+  m_.step(p_, drive(b, CUP_MOTOR_OUT[i_]), stock_ == 0, dtUs);
+  float before = phase_;
+  phase_ += m_.speed * dtUs / (p_.cupTurnMs * 1000.0f);
+  if ((int)phase_ != (int)before && stock_ > 0) stock_--;  // 1회전 = 컵 1개
+  float frac = phase_ - (int)phase_;
+  b.setInput(CUP_ROT_IN[i_], (frac >= 0.96f && frac < 0.985f) ? LOW : HIGH);
+  b.setInput(CUP_DISP_IN[i_], (frac >= 0.5f && frac < 0.6f) ? HIGH : LOW);
+  b.setInput(CUP_STOCK_IN[i_], stock_ > 0 ? HIGH : LOW);
+  b.setAnalog(CUP_CURR_AIN[i_], adc(b, p_, m_.amp));
+}
+
+// ===== Ramen =====
+void RamenMech::begin(SimBoard& b) {
+  b.setInput(RAMEN_UP_BTM_IN[i_], HIGH);
+  b.setInput(RAMEN_UP_TOP_IN[i_], LOW);
+  b.setInput(RAMEN_EJ_BTM_IN[i_], HIGH);
+  b.setInput(RAMEN_EJ_TOP_IN[i_], LOW);
+  b.setInput(RAMEN_PRESENT_IN[i_], HIGH);
+  b.setInput(RAMEN_ENCORDER[i_ * 2], LOW);
+  b.setInput(RAMEN_ENCORDER[i_ * 2 + 1], LOW);
+}
+
+// 엔코더 위치를 1카운트씩 따라가며 A/B 직교 신호를 만든다 (00,01,11,10 순서 = 정방향)
+void RamenMech::emitEncoder(SimBoard& b, int32_t target) {
+  static const uint8_t gray[4] = {0x0, 0x1, 0x3, 0x2};
+  while (encPos_ != target) {
+    encPos_ += (target > encPos_) ? 1 : -1;
+    uint8_t g = gray[encPos_ & 3];
+    b.setInput(RAMEN_ENCORDER[i_ * 2], (g >> 1) & 1);
+    b.setInput(RAMEN_ENCORDER[i_ * 2 + 1], g & 1);
+  }
+}
+
+void RamenMech::step(SimBoard& b, uint32_t dtUs) {
+  const float dt = dtUs / 1000000.0f;
+  const int32_t top = p_.ramenLiftTopCounts;
+  const float presentAt = (float)p_.ramenPresentCounts + (p_.ramenStock - stock_) * 80.0f;
+
+  // 리프트 (엔코더 모터)
+  bool fwd = b.outputHigh(RAMEN_UP_FWD_OUT[i_]);
+  bool rev = b.outputHigh(RAMEN_UP_REV_OUT[i_]);
+  int dir = (fwd && !rev) ? 1 : ((rev && !fwd) ? -1 : 0);
+  bool liftStall = (dir > 0 && liftPos_ >= top) || (dir < 0 && liftPos_ <= 0) ||
+                   (dir > 0 && stock_ > 0 && liftPos_ >= presentAt + 40) ||
+                   (dir > 0 && p_.ramenJamCounts >= 0 && liftPos_ >= p_.ramenJamCounts);
+  lift_.step(p_, dir > 0 ? drive(b, RAMEN_UP_FWD_OUT[i_]) : (dir < 0 ? drive(b, RAMEN_UP_REV_OUT[i_]) : 0.0f),
+             liftStall, dtUs);
+  if (dir != 0) liftDir_ = dir;
+  liftPos_ += liftDir_ * lift_.speed * p_.ramenLiftCountsPerSec * dt;
+  if (liftPos_ < 0) liftPos_ = 0;
+  if (liftPos_ > top) liftPos_ = (float)top;
+  emitEncoder(b, (int32_t)liftPos_);
+
+  b.setInput(RAMEN_UP_TOP_IN[i_], liftPos_ >= top - 1 ? HIGH : LOW);
+  b.setInput(RAMEN_UP_BTM_IN[i_], liftPos_ <= 0.5f ? HIGH : LOW);
+  bool present = stock_ > 0 && liftPos_ >= presentAt;
+  b.setInput(RAMEN_PRESENT_IN[i_], present ? LOW : HIGH);
+
+  // 배출 리니어 액추에이터
+  bool efwd = b.outputHigh(RAMEN_EJ_FWD_OUT[i_]);
+  bool erev = b.outputHigh(RAMEN_EJ_REV_OUT[i_]);
+  int edir = (efwd && !erev) ? 1 : ((erev && !efwd) ? -1 : 0);
+  bool ejStall = (edir > 0 && ejPos_ >= 1) || (edir < 0 && ejPos_ <= 0);
+  eject_.step(p_, edir > 0 ? drive(b, RAMEN_EJ_FWD_OUT[i_]) : (edir < 0 ? drive(b, RAMEN_EJ_REV_OUT[i_]) : 0.0f),
+              ejStall, dtUs);
+  if (edir != 0) ejDir_ = edir;
+  ejPos_ = clamp01(ejPos_ + ejDir_ * eject_.speed * dtUs / (p_.ramenEjectMs * 1000.0f));
+  if (ejPos_ >= 1 && !ejected_ && present) {
+    stock_--;
+    ejected_ = true;
+  }
+  if (ejPos_ <= 0) ejected_ = false;
+
+  b.setInput(RAMEN_EJ_TOP_IN[i_], ejPos_ >= 1 ? HIGH : LOW);
+  b.setInput(RAMEN_EJ_BTM_IN[i_], ejPos_ <= 0 ? HIGH : LOW);
+  b.setAnalog(RAMEN_UP_CURR_AIN[i_], adc(b, p_, lift_.amp));
+  b.setAnalog(RAMEN_EJ_CURR_AIN[i_], adc(b, p_, eject_.amp));
+}
+
+// ===== Powder =====
+void PowderMech::step(SimBoard& b, uint32_t dtUs) {
+  m_.step(p_, drive(b, POWDER_MOTOR_OUT[i_]), false, dtUs);
+  b.setAnalog(POWDER_CURR_AIN[i_], adc(b, p_, m_.amp));
+}
+
+// ===== Outlet =====
+void OutletMech::begin(SimBoard& b) {
+  b.setInput(OUTLET_OPEN_IN[i_], HIGH);
+  b.setInput(OUTLET_CLOSE_IN[i_], LOW);
+}
+
+void OutletMech::step(SimBoard& b, uint32_t dtUs) {
+  bool fwd = b.outputHigh(OUTLET_FWD_OUT[i_]);
+  bool rev = b.outputHigh(OUTLET_REV_OUT[i_]);
+  int dir = (fwd && !rev) ? 1 : ((rev && !fwd) ? -1 : 0);
+  bool stall = (dir > 0 && pos_ >= 1) || (dir < 0 && pos_ <= 0);
+  m_.step(p_, dir > 0 ? drive(b, OUTLET_FWD_OUT[i_]) : (dir < 0 ? drive(b, OUTLET_REV_OUT[i_]) : 0.0f),
+           stall, dtUs);
+  if (dir != 0) dir_ = dir;
+  pos_ = clamp01(pos_ + dir_ * m_.speed * dtUs / (p_.outletTravelMs * 1000.0f));
+
+  // 완전히 열린 뒤 0.8초 후 그릇이 놓이고, 닫히기 시작하면 치워진다
+  if (pos_ >= 1) {
+    openUs_ += dtUs;
+    if (openUs_ >= 800000) bowl_ = true;
+  } else {
+    openUs_ = 0;
+    if (dir < 0) bowl_ = false;
+  }
+
+  b.setInput(OUTLET_OPEN_IN[i_], pos_ >= 1 ? LOW : HIGH);
+  b.setInput(OUTLET_CLOSE_IN[i_], pos_ <= 0 ? LOW : HIGH);
+  b.setAnalog(OUTLET_CURR_AIN[i_], adc(b, p_, m_.amp));
+  b.setAnalog(OUTLET_LOAD_AIN[i_], adc(b, p_, bowl_ ? 500.0f : 80.0f));
+  b.setAnalog(OUTLET_USONIC_AIN[i_], adc(b, p_, bowl_ ? 180.0f : 620.0f));
+}
+
+// ===== Cooker =====
+void CookerMech::step(SimBoard& b, uint32_t dtUs) {
+  float target = (float)p_.ampIdle;
+  if (b.outputHigh(COOKER_IND_SIG[i_])) target += 700;
+  if (b.outputHigh(COOKER_WTR_SIG[i_])) target += 150;
+  float k = dtUs / 200000.0f;  // 유도가열 전류 시정수 200ms
+  amp_ += (target - amp_) * (k > 1 ? 1 : k);
+  b.setAnalog(COOKER_CURR_AIN[i_], adc(b, p_, amp_));
+}
+
+// ===== Door =====
+void DoorMech::begin(SimBoard& b) {
+  b.setInput(DOOR_SENSOR1_PIN, p_.door1);
+  b.setInput(DOOR_SENSOR2_PIN, p_.door2);
+}
@@ -0,0 +1,119 @@
+#ifndef HOST_SIM_MECH_H
+#define HOST_SIM_MECH_H
+
+#include "sim_board.h"
+
+// =======================================================
+// === 장비별 기구 모델
+// === 핀맵은 펌웨어와 동일하게 ../config.h 를 사용한다.
+// === 시간/전류 값은 SimParams 로 조정 (ADC 는 10bit 원시값)
+// =======================================================
+
+struct SimParams {
+  // Cup: 1회전(1컵) 소요 시간, 회전 감지 캠 위치
+  uint32_t cupTurnMs = 1000;
+  uint16_t cupStock = 20;
+  // Ramen: 리프트 속도 및 행정 (엔코더 카운트, CPR=400)
+  uint32_t ramenLiftCountsPerSec = 1200;
+  int32_t ramenLiftTopCounts = 2400;
+  int32_t ramenPresentCounts = 1600;
+  uint32_t ramenEjectMs = 1500;
+  uint16_t ramenStock = 10;
+  int32_t ramenJamCounts = -1;   // >= 0: 리프트가 이 위치에서 걸림 (정체 감지 시험용)
+  // Outlet: 도어 개폐 시간
+  uint32_t outletTravelMs = 1200;
+  // 전류 모델 (ADC 카운트)
+  int ampIdle = 20;
+  int ampRun = 350;
+  int ampStall = 950;
+  uint32_t inrushMs = 40;
+  int adcNoise = 3;
+  // Door
+  int door1 = LOW;
+  int door2 = LOW;
+};
+
+// 모터 전류: 기동 돌입전류 -> 정상 전류, 구속 시 stall 전류
+struct MotorModel {
+  float speed = 0;   // 0..1 (정격 대비 회전 속도)
+  float amp = 0;
+  void step(const SimParams& p, float drive, bool stalled, uint32_t dtUs);
+};
+
+class CupMech : public Mechanism {
+ public:
+  CupMech(uint8_t idx, const SimParams& p) : i_(idx), p_(p), stock_(p.cupStock) {}
+  void begin(SimBoard& b) override;
+  void step(SimBoard& b, uint32_t dtUs) override;
+ private:
+  uint8_t i_;
+  const SimParams& p_;
+  MotorModel m_;
+  float phase_ = 0;
+  uint16_t stock_;
+};
+
+class RamenMech : public Mechanism {
+ public:
+  RamenMech(uint8_t idx, const SimParams& p) : i_(idx), p_(p), stock_(p.ramenStock) {}
+  void begin(SimBoard& b) override;
+  void step(SimBoard& b, uint32_t dtUs) override;
+ private:
+  void emitEncoder(SimBoard& b, int32_t target);
+  uint8_t i_;
+  const SimParams& p_;
+  MotorModel lift_, eject_;
+  float liftPos_ = 0;       // 엔코더 카운트 단위
+  int liftDir_ = 1;
+  int ejDir_ = 1;
+  int32_t encPos_ = 0;      // 마지막으로 출력한 엔코더 위치
+  float ejPos_ = 0;         // 0=후퇴, 1=전진
+  bool ejected_ = false;
+  uint16_t stock_;
+};
+
+class PowderMech : public Mechanism {
+ public:
+  PowderMech(uint8_t idx, const SimParams& p) : i_(idx), p_(p) {}
+  void step(SimBoard& b, uint32_t dtUs) override;
+ private:
+  uint8_t i_;
+  const SimParams& p_;
+  MotorModel m_;
+};
+
+class OutletMech : public Mechanism {
+ public:
+  OutletMech(uint8_t idx, const SimParams& p) : i_(idx), p_(p) {}
+  void begin(SimBoard& b) override;
+  void step(SimBoard& b, uint32_t dtUs) override;
+ private:
+  uint8_t i_;
+  const SimParams& p_;
+  MotorModel m_;
+  float pos_ = 0;           // 0=닫힘, 1=열림
+  int dir_ = 1;
+  uint32_t openUs_ = 0;     // 완전 열림 유지 시간
+  bool bowl_ = false;
+};
+
+class CookerMech : public Mechanism {
+ public:
+  CookerMech(uint8_t idx, const SimParams& p) : i_(idx), p_(p) {}
+  void step(SimBoard& b, uint32_t dtUs) override;
+ private:
+  uint8_t i_;
+  const SimParams& p_;
+  float amp_ = 0;
+};
+
+class DoorMech : public Mechanism {
+ public:
+  explicit DoorMech(const SimParams& p) : p_(p) {}
+  void begin(SimBoard& b) override;
+  void step(SimBoard& b, uint32_t dtUs) override { (void)b; (void)dtUs; }
+ private:
+  const SimParams& p_;
+};
+
+#endif // HOST_SIM_MECH_H
@@ -0,0 +1,3 @@
+// 스케치(.ino)를 수정 없이 호스트에서 C++ 로 컴파일하기 위한 래퍼.
+// Arduino IDE 는 host/ 디렉터리를 빌드하지 않으므로 장비 빌드에는 영향이 없다.
+#include "../rs232_botty_2025_1001_02_due.ino"
@@ -0,0 +1,159 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <string.h>
+#include "limit.h"
+#include "actuator.h"
+#include "motor.h"
+#include "fastio.h"
+#include "txbuffer.h"
+#include "evlog.h"
+
+struct LimitSlot {
+  uint8_t pin;
+  uint8_t out;        // 끊을 출력 핀
+  uint8_t active;     // 활성 레벨 (HIGH/LOW)
+  bool hit;           // loop 전용: limitHit() 이 소비
+};
+
+static LimitSlot slots[LIMIT_MAX_SLOTS];
+static uint8_t slotCount = 0;
+static uint8_t slotOf[LIMIT_KIND_COUNT][ACTUATOR_MAX_UNITS];   // 0xFF = 없음
+
+// ISR -> loop 이벤트 링 (head 는 ISR 만, tail 은 loop 만 씀)
+static uint8_t queueSlot[LIMIT_QUEUE_SIZE];
+static uint32_t queueUs[LIMIT_QUEUE_SIZE];
+static volatile uint8_t queueHead = 0;
+static volatile uint8_t queueTail = 0;
+
+static volatile uint32_t droppedCount = 0;
+static uint32_t isrCount = 0;
+static uint32_t pollCount = 0;
+static uint32_t lagMaxUs = 0;
+
+static inline uint8_t readLevel(const LimitSlot& s) {
+  return fioReadNow(s.pin);   // ISR: 스냅샷이 아닌 현재 레벨
+}
+
+// =======================================================
+// === ISR
+// =======================================================
+
+static inline void limitEdge(uint8_t n) {
+  LimitSlot& s = slots[n];
+  uint8_t level = readLevel(s);
+  evlogPut(EV_LIMIT, s.pin, level);
+  if (level != s.active || !motorOn(s.out)) return;
+  motorStop(s.out);
+  uint8_t h = queueHead;
+  if ((uint8_t)(h - queueTail) >= LIMIT_QUEUE_SIZE) { droppedCount = droppedCount + 1; return; }
+  queueSlot[h & (LIMIT_QUEUE_SIZE - 1)] = n;
+  queueUs[h & (LIMIT_QUEUE_SIZE - 1)] = micros();
+  queueHead = (uint8_t)(h + 1);
+}
+
+// attachInterrupt 는 인자 없는 함수만 받으므로 슬롯별 ISR 을 템플릿으로 생성
+template <uint8_t N>
+static void limitIsr() { limitEdge(N); }
+
+static void (* const LIMIT_ISRS[LIMIT_MAX_SLOTS])(void) = {
+  limitIsr<0>,  limitIsr<1>,  limitIsr<2>,  limitIsr<3>,
+  limitIsr<4>,  limitIsr<5>,  limitIsr<6>,  limitIsr<7>,
+  limitIsr<8>,  limitIsr<9>,  limitIsr<10>, limitIsr<11>,
+  limitIsr<12>, limitIsr<13>, limitIsr<14>, limitIsr<15>
+};
+
+// =======================================================
+// === 설정
+// =======================================================
+
+static void addSlot(uint8_t kind, uint8_t unit, uint8_t pin, uint8_t out, uint8_t active) {
+  if (slotCount >= LIMIT_MAX_SLOTS) return;
+  LimitSlot& s = slots[slotCount];
+  s.pin = pin;
+  s.out = out;
+  s.active = active;
+  s.hit = false;
+  slotOf[kind][unit] = slotCount;
+  attachInterrupt(digitalPinToInterrupt(pin), LIMIT_ISRS[slotCount], CHANGE);
+  slotCount++;
+}
+
+void limitConfigure(const Setting& s) {
+  // 핀이 장비 간에 겹치므로 (cup 입력 = ramen 출력 등) 이전 연결부터 해제
+  for (uint8_t n = 0; n < slotCount; n++) detachInterrupt(digitalPinToInterrupt(slots[n].pin));
+  slotCount = 0;
+  memset(slotOf, 0xFF, sizeof(slotOf));
+  noInterrupts();
+  queueTail = queueHead;
+  interrupts();
+
+  for (uint8_t i = 0; i < s.cup; i++) {
+    addSlot(LIMIT_CUP_ROT, i, CUP_ROT_IN[i], CUP_MOTOR_OUT[i], LOW);
+  }
+  for (uint8_t i = 0; i < s.ramen; i++) {
+    addSlot(LIMIT_RAMEN_UP_TOP, i, RAMEN_UP_TOP_IN[i], RAMEN_UP_FWD_OUT[i], HIGH);
+    addSlot(LIMIT_RAMEN_UP_BTM, i, RAMEN_UP_BTM_IN[i], RAMEN_UP_REV_OUT[i], HIGH);
+    addSlot(LIMIT_RAMEN_EJ_TOP, i, RAMEN_EJ_TOP_IN[i], RAMEN_EJ_FWD_OUT[i], HIGH);
+    addSlot(LIMIT_RAMEN_EJ_BTM, i, RAMEN_EJ_BTM_IN[i], RAMEN_EJ_REV_OUT[i], HIGH);
+  }
+  for (uint8_t i = 0; i < s.outlet; i++) {
+    addSlot(LIMIT_OUTLET_OPEN, i, OUTLET_OPEN_IN[i], OUTLET_FWD_OUT[i], LOW);
+    addSlot(LIMIT_OUTLET_CLOSE, i, OUTLET_CLOSE_IN[i], OUTLET_REV_OUT[i], LOW);
+  }
+}
+
+// =======================================================
+// === loop 측
+// =======================================================
+
+void limitPoll() {
+  while (queueTail != queueHead) {
+    uint8_t t = queueTail & (LIMIT_QUEUE_SIZE - 1);
+    uint32_t lag = micros() - queueUs[t];
+    if (lag > lagMaxUs) lagMaxUs = lag;
+    slots[queueSlot[t]].hit = true;
+    isrCount++;
+    queueTail = (uint8_t)(queueTail + 1);
+  }
+
+  for (uint8_t n = 0; n < slotCount; n++) {
+    LimitSlot& s = slots[n];
+    if (s.hit) continue;
+    // 확인과 차단 사이에 ISR 이 같은 스위치를 처리하지 않도록
+    noInterrupts();
+    bool cut = motorOn(s.out) && readLevel(s) == s.active;
+    if (cut) motorStop(s.out);
+    interrupts();
+    if (cut) {
+      s.hit = true;
+      pollCount++;
+    }
+  }
+}
+
+bool limitHit(uint8_t kind, uint8_t unit) {
+  uint8_t n = slotOf[kind][unit];
+  if (n == 0xFF || !slots[n].hit) return false;
+  slots[n].hit = false;
+  return true;
+}
+
+void replyLimitStats() {
+  StaticJsonDocument<160> doc;
+  doc["device"] = "stats";
+  doc["stage"] = "limit";
+  doc["switches"] = slotCount;
+  doc["isr"] = isrCount;
+  doc["poll"] = pollCount;
+  doc["dropped"] = droppedCount;
+  doc["lag_max_us"] = lagMaxUs;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+void limitResetStats() {
+  isrCount = 0;
+  pollCount = 0;
+  droppedCount = 0;
+  lagMaxUs = 0;
+}
@@ -0,0 +1,46 @@
+#ifndef LIMIT_H
+#define LIMIT_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "state.h"
+
+// =======================================================
+// === 리밋 스위치 인터럽트 (PIO 에지 -> ISR 에서 바로 모터 차단)
+// === - 스위치마다 CHANGE 인터럽트. 활성 레벨이고 해당 방향 출력이 켜져 있으면
+// ===   ISR 안에서 motorStop() 후 이벤트 큐에 등록 → 정지 지연이 loop 부하와 무관
+// === - 큐는 단일 생산자(PIO ISR 끼리는 같은 우선순위라 서로 끼어들지 않음) /
+// ===   단일 소비자(loop) 링. 출력이 켜져 있을 때만 등록하므로 스위치당 최대 1건
+// === - limitPoll(): 큐를 비워 스위치별 hit 표시. 에지를 놓친 경우(시작 시 이미
+// ===   활성 등)를 위해 출력이 켜진 스위치는 레벨도 확인 (기존 폴링과 같은 조건)
+// === - check* 함수는 limitHit() 으로 완료를 받아 보고/동작 감시 처리
+// === - {"device":"stats"} 의 "limit": isr/poll 차단 수, ISR -> loop 처리 지연
+// =======================================================
+
+enum LimitKind : uint8_t {
+  LIMIT_CUP_ROT = 0,     // CUP_ROT_IN LOW    -> CUP_MOTOR_OUT
+  LIMIT_RAMEN_UP_TOP,    // RAMEN_UP_TOP_IN HIGH -> RAMEN_UP_FWD_OUT
+  LIMIT_RAMEN_UP_BTM,    // RAMEN_UP_BTM_IN HIGH -> RAMEN_UP_REV_OUT
+  LIMIT_RAMEN_EJ_TOP,    // RAMEN_EJ_TOP_IN HIGH -> RAMEN_EJ_FWD_OUT
+  LIMIT_RAMEN_EJ_BTM,    // RAMEN_EJ_BTM_IN HIGH -> RAMEN_EJ_REV_OUT
+  LIMIT_OUTLET_OPEN,     // OUTLET_OPEN_IN LOW   -> OUTLET_FWD_OUT
+  LIMIT_OUTLET_CLOSE,    // OUTLET_CLOSE_IN LOW  -> OUTLET_REV_OUT
+  LIMIT_KIND_COUNT
+};
+
+const uint8_t LIMIT_MAX_SLOTS = 16;   // ramen 4 x 4 가 최대
+const uint8_t LIMIT_QUEUE_SIZE = 16;  // 2 의 거듭제곱, >= LIMIT_MAX_SLOTS 이면 넘치지 않음
+
+/** @brief 설정된 장비의 스위치에 인터럽트 연결 (이전 설정의 연결은 해제) */
+void limitConfigure(const Setting& s);
+
+/** @brief ISR 이벤트 처리 + 레벨 확인 (loop 에서, 장비 check* 전에) */
+void limitPoll();
+
+/** @brief 스위치가 출력을 끊었으면 true (한 번만) */
+bool limitHit(uint8_t kind, uint8_t unit);
+
+void replyLimitStats();
+void limitResetStats();
+
+#endif // LIMIT_H
@@ -0,0 +1,308 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <string.h>
+#include "measure.h"
+#include "adc.h"
+#include "nvconfig.h"
+#include "txbuffer.h"
+
+static const char* const KIND_NAMES[MEAS_KIND_COUNT] = { "outlet_load", "outlet_sonar", "ramen_load" };
+static const char* const KIND_UNITS[MEAS_KIND_COUNT] = { "g", "mm", "g" };
+struct MeasChannel {
+  uint8_t pin;                  // NO_AIN = 구성 안 됨
+  uint8_t shift;                // IIR
+  uint8_t pos;
+  uint8_t filled;
+  uint16_t window[MEAS_MEDIAN_N];
+  int32_t iirQ8;
+  volatile int32_t filteredQ8;  // loop 가 읽는 값 (32bit 정렬 → 원자적)
+  int32_t gainQ16;              // (val2 - val1) / (raw2 - raw1)
+};
+
+struct BowlState {
+  bool present;
+  bool pending;                 // 반대 상태로 바뀌는 중 (디바운스)
+  unsigned long sinceMs;
+  int32_t fillTarget;           // 0 = 감시 안 함
+};
+
+static MeasCal cals[MEAS_KIND_COUNT][MEAS_UNITS];
+static MeasChannel channels[MEAS_KIND_COUNT][MEAS_UNITS];
+static BowlState bowls[MEAS_UNITS];
+static uint8_t tickDiv = 0;
+
+// =======================================================
+// === 교정
+// =======================================================
+
+static void defaultCal(uint8_t kind, MeasCal& c) {
+  c.raw1 = 0;
+  c.raw2 = 1023;
+  c.val1 = 0;
+  c.val2 = (kind == MEAS_OUTLET_SONAR) ? MEAS_SONAR_FULL_MM : MEAS_LOAD_FULL_G;
+  c.tare = 0;
+}
+
+static void updateGain(uint8_t kind, uint8_t unit) {
+  const MeasCal& c = cals[kind][unit];
+  int32_t span = c.raw2 - c.raw1;
+  channels[kind][unit].gainQ16 = span ? (int32_t)(((int64_t)(c.val2 - c.val1) << 16) / span) : 0;
+}
+
+// 영점 적용 전 값
+static int32_t calibrated(uint8_t kind, uint8_t unit) {
+  const MeasCal& c = cals[kind][unit];
+  const MeasChannel& ch = channels[kind][unit];
+  int32_t d = ch.filteredQ8 - ((int32_t)c.raw1 << 8);
+  return c.val1 + (int32_t)(((int64_t)d * ch.gainQ16) >> 24);
+}
+
+void measureBegin() {
+  for (uint8_t k = 0; k < MEAS_KIND_COUNT; k++) {
+    for (uint8_t u = 0; u < MEAS_UNITS; u++) {
+      defaultCal(k, cals[k][u]);
+      channels[k][u].pin = NO_AIN;
+      updateGain(k, u);
+    }
+  }
+}
+
+void measureGetCal(MeasCal out[MEAS_KIND_COUNT][MEAS_UNITS]) {
+  memcpy(out, cals, sizeof(cals));
+}
+
+void measureSetCal(const MeasCal in[MEAS_KIND_COUNT][MEAS_UNITS]) {
+  memcpy(cals, in, sizeof(cals));
+  for (uint8_t k = 0; k < MEAS_KIND_COUNT; k++) {
+    for (uint8_t u = 0; u < MEAS_UNITS; u++) updateGain(k, u);
+  }
+}
+
+// =======================================================
+// === 채널 구성 / 샘플링
+// =======================================================
+
+static void setupChannel(uint8_t kind, uint8_t unit, uint8_t pin, uint8_t shift) {
+  MeasChannel& ch = channels[kind][unit];
+  ch.shift = shift;
+  ch.pos = 0;
+  ch.filled = 0;
+  ch.iirQ8 = 0;
+  ch.filteredQ8 = 0;
+  ch.pin = pin;   // 마지막에: tick 은 pin 이 정해진 채널만 처리
+}
+
+void measureConfigure(const Setting& s) {
+  noInterrupts();
+  for (uint8_t k = 0; k < MEAS_KIND_COUNT; k++) {
+    for (uint8_t u = 0; u < MEAS_UNITS; u++) channels[k][u].pin = NO_AIN;
+  }
+  interrupts();
+  for (uint8_t u = 0; u < MEAS_UNITS; u++) {
+    bowls[u].present = false;
+    bowls[u].pending = false;
+    bowls[u].fillTarget = 0;
+  }
+
+  noInterrupts();
+  for (uint8_t i = 0; i < s.outlet; i++) {
+    setupChannel(MEAS_OUTLET_LOAD, i, OUTLET_LOAD_AIN[i], MEAS_LOAD_SHIFT);
+    setupChannel(MEAS_OUTLET_SONAR, i, OUTLET_USONIC_AIN[i], MEAS_SONAR_SHIFT);
+  }
+  for (uint8_t i = 0; i < s.ramen; i++) {
+    if (RAMEN_LOAD_AIN[i] != NO_AIN) setupChannel(MEAS_RAMEN_LOAD, i, RAMEN_LOAD_AIN[i], MEAS_LOAD_SHIFT);
+  }
+  interrupts();
+}
+
+// 삽입 정렬 후 가운데 (N <= 7)
+static uint16_t median(const uint16_t* w, uint8_t n) {
+  uint16_t s[MEAS_MEDIAN_N];
+  for (uint8_t i = 0; i < n; i++) {
+    uint16_t v = w[i];
+    int8_t j = (int8_t)i - 1;
+    while (j >= 0 && s[j] > v) { s[j + 1] = s[j]; j--; }
+    s[j + 1] = v;
+  }
+  return s[n / 2];
+}
+
+void measureTick() {
+  if (++tickDiv < MEAS_TICK_DIV) return;
+  tickDiv = 0;
+  for (uint8_t k = 0; k < MEAS_KIND_COUNT; k++) {
+    for (uint8_t u = 0; u < MEAS_UNITS; u++) {
+      MeasChannel& ch = channels[k][u];
+      if (ch.pin == NO_AIN) continue;
+      ch.window[ch.pos] = (uint16_t)adcReadRaw(ch.pin);
+      if (++ch.pos >= MEAS_MEDIAN_N) ch.pos = 0;
+      if (ch.filled < MEAS_MEDIAN_N) {
+        ch.filled++;
+        if (ch.filled == 1) ch.iirQ8 = (int32_t)ch.window[0] << 8;   // 첫 샘플로 초기화 (0 부터 올라오지 않게)
+      }
+      int32_t x = (int32_t)median(ch.window, ch.filled) << 8;
+      ch.iirQ8 += (x - ch.iirQ8) >> ch.shift;
+      ch.filteredQ8 = ch.iirQ8;
+    }
+  }
+}
+
+// =======================================================
+// === loop 측
+// =======================================================
+
+int32_t measureValue(uint8_t kind, uint8_t unit) {
+  if (kind >= MEAS_KIND_COUNT || unit >= MEAS_UNITS || channels[kind][unit].pin == NO_AIN) return 0;
+  return calibrated(kind, unit) - cals[kind][unit].tare;
+}
+
+bool measureBowlPresent(uint8_t unit) {
+  return unit < MEAS_UNITS && bowls[unit].present;
+}
+
+static void reportBowl(uint8_t unit, int32_t grams) {
+  StaticJsonDocument<128> doc;
+  doc["device"] = "measure";
+  doc["event"] = "bowl";
+  doc["control"] = unit + 1;
+  doc["present"] = bowls[unit].present;
+  doc["grams"] = grams;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+void measurePoll() {
+  unsigned long now = millis();
+  for (uint8_t u = 0; u < MEAS_UNITS; u++) {
+    if (channels[MEAS_OUTLET_LOAD][u].pin == NO_AIN) continue;
+    BowlState& b = bowls[u];
+    int32_t g = measureValue(MEAS_OUTLET_LOAD, u);
+
+    bool toggle = b.present ? (g < MEAS_BOWL_OFF_G) : (g >= MEAS_BOWL_ON_G);
+    if (!toggle) {
+      b.pending = false;
+    } else if (!b.pending) {
+      b.pending = true;
+      b.sinceMs = now;
+    } else if (now - b.sinceMs >= MEAS_BOWL_DEBOUNCE_MS) {
+      b.present = !b.present;
+      b.pending = false;
+      reportBowl(u, g);
+    }
+
+    if (b.fillTarget > 0 && g >= b.fillTarget) {
+      StaticJsonDocument<128> doc;
+      doc["device"] = "measure";
+      doc["event"] = "fill";
+      doc["control"] = u + 1;
+      doc["grams"] = g;
+      doc["target"] = b.fillTarget;
+      serializeJson(doc, TxEvent);
+      TxEvent.println();
+      b.fillTarget = 0;   // 한 번만
+    }
+  }
+}
+
+// =======================================================
+// === {"device":"measure"} 명령
+// =======================================================
+
+static void replyChannel(uint8_t kind, uint8_t unit) {
+  const MeasCal& c = cals[kind][unit];
+  StaticJsonDocument<256> doc;
+  doc["device"] = "measure";
+  doc["target"] = KIND_NAMES[kind];
+  doc["control"] = unit + 1;
+  doc["raw"] = (channels[kind][unit].filteredQ8 + 128) >> 8;
+  doc["value"] = measureValue(kind, unit);
+  doc["unit"] = KIND_UNITS[kind];
+  doc["tare"] = c.tare;
+  doc["raw1"] = c.raw1;
+  doc["val1"] = c.val1;
+  doc["raw2"] = c.raw2;
+  doc["val2"] = c.val2;
+  if (kind == MEAS_OUTLET_LOAD) doc["bowl"] = bowls[unit].present;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+static int findKind(const char* name) {
+  for (uint8_t k = 0; k < MEAS_KIND_COUNT; k++) {
+    if (strcmp(name, KIND_NAMES[k]) == 0) return k;
+  }
+  return -1;
+}
+
+bool handleMeasureJson(JsonVariantConst doc) {
+  const char* func = doc["function"] | "status";
+  const char* targetName = doc["target"] | "";
+  int control = doc["control"] | 0;
+  int kind = -1;
+  if (targetName[0] != '\0') {
+    kind = findKind(targetName);
+    if (kind < 0) { TxEvent.println("unknown measure target"); return false; }
+  }
+  if (control < 0 || control > MEAS_UNITS) { TxEvent.println("invalid measure control num"); return false; }
+
+  if (strcmp(func, "save") == 0) {
+    return configSave();   // 교정은 전체 설정 레코드의 일부
+  }
+
+  bool perChannel = strcmp(func, "tare") == 0 || strcmp(func, "cal") == 0 ||
+                    strcmp(func, "set") == 0 || strcmp(func, "watch") == 0;
+  if (perChannel) {
+    if (kind < 0 || control == 0) { TxEvent.println("measure needs target and control"); return false; }
+    uint8_t u = (uint8_t)(control - 1);
+    if (channels[kind][u].pin == NO_AIN) { TxEvent.println("measure channel not configured"); return false; }
+    MeasCal& c = cals[kind][u];
+
+    if (strcmp(func, "tare") == 0) {
+      c.tare = calibrated(kind, u);
+    } else if (strcmp(func, "cal") == 0) {
+      int point = doc["point"] | 0;
+      if ((point != 1 && point != 2) || !doc["value"].is<long>()) {
+        TxEvent.println("measure cal needs point (1|2) and value");
+        return false;
+      }
+      int16_t raw = (int16_t)((channels[kind][u].filteredQ8 + 128) >> 8);
+      int16_t other = (point == 1) ? c.raw2 : c.raw1;
+      if (raw == other) { TxEvent.println("measure cal points too close"); return false; }
+      if (point == 1) { c.raw1 = raw; c.val1 = doc["value"].as<long>(); }
+      else { c.raw2 = raw; c.val2 = doc["value"].as<long>(); }
+    } else if (strcmp(func, "set") == 0) {
+      MeasCal n = c;
+      n.raw1 = (int16_t)(doc["raw1"] | (long)c.raw1);
+      n.raw2 = (int16_t)(doc["raw2"] | (long)c.raw2);
+      n.val1 = doc["val1"] | (long)c.val1;
+      n.val2 = doc["val2"] | (long)c.val2;
+      n.tare = doc["tare"] | (long)c.tare;
+      if (n.raw1 == n.raw2) { TxEvent.println("measure cal points too close"); return false; }
+      c = n;
+    } else {   // watch
+      if (kind != MEAS_OUTLET_LOAD) { TxEvent.println("measure watch is for outlet_load"); return false; }
+      long grams = doc["grams"] | 0L;
+      bowls[u].fillTarget = grams > 0 ? grams : 0;
+    }
+    updateGain(kind, u);
+  } else if (strcmp(func, "reset") == 0) {
+    for (uint8_t k = 0; k < MEAS_KIND_COUNT; k++) {
+      for (uint8_t u = 0; u < MEAS_UNITS; u++) {
+        if ((kind >= 0 && kind != k) || (control > 0 && control != u + 1)) continue;
+        defaultCal(k, cals[k][u]);
+        updateGain(k, u);
+      }
+    }
+  } else if (strcmp(func, "status") != 0) {
+    TxEvent.println("unknown measure function");
+    return false;
+  }
+
+  for (uint8_t k = 0; k < MEAS_KIND_COUNT; k++) {
+    for (uint8_t u = 0; u < MEAS_UNITS; u++) {
+      if (channels[k][u].pin == NO_AIN) continue;
+      if ((kind < 0 || kind == k) && (control == 0 || control == u + 1)) replyChannel(k, u);
+    }
+  }
+  return true;
+}
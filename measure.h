@@ -0,0 +1,70 @@
+#ifndef MEASURE_H
+#define MEASURE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "state.h"
+
+// =======================================================
+// === 로드셀 / 초음파 측정 파이프라인 (채널별, 정수 고정소수점)
+// === - fastTick 에서 MEAS_TICK_DIV 마다 adcReadRaw() 샘플 (500Hz)
+// ===   → 중앙값(MEAS_MEDIAN_N) 으로 스파이크 제거 → 1차 IIR (Q8)
+// === - 2점 교정: (raw1 -> val1), (raw2 -> val2), 기울기는 Q16 으로 미리 계산
+// ===   값 = val1 + (filtered - raw1) x gain - tare   (단위: g / mm)
+// === - 교정/영점은 설정 저장소(nvconfig.h)에 함께 저장/복원
+// ===   ({"device":"measure","function":"save"} = {"device":"config","function":"save"})
+// === - 배출구 로드셀: 그릇 감지(히스테리시스 + 디바운스)와 목표 무게 도달을
+// ===   loop 에서 판정해 이벤트로 보냄
+// ===   {"device":"measure","event":"bowl","control":..,"present":..,"grams":..}
+// ===   {"device":"measure","event":"fill","control":..,"grams":..,"target":..}
+// === - 명령: {"device":"measure","function":"status|tare|cal|set|watch|save|reset",
+// ===         "target":"outlet_load|outlet_sonar|ramen_load","control":N, ...}
+// ===   cal: "point":1|2, "value":현재 하중/거리 → 현재 필터 값을 그 점의 raw 로
+// ===   set: raw1, val1, raw2, val2, tare 직접 지정
+// ===   watch: "grams":목표 (배출구 로드셀, 0 = 해제)
+// =======================================================
+
+enum MeasKind : uint8_t {
+  MEAS_OUTLET_LOAD = 0,   // g
+  MEAS_OUTLET_SONAR,      // mm
+  MEAS_RAMEN_LOAD,        // g (RAMEN_LOAD_AIN 배선 시)
+  MEAS_KIND_COUNT
+};
+
+const uint8_t MEAS_UNITS = 4;   // 종류별 최대 장비 수 (outlet / ramen)
+
+// 2점 교정 + 영점 (raw = ADC count, val = g / mm)
+struct MeasCal {
+  int16_t raw1;
+  int16_t raw2;
+  int32_t val1;
+  int32_t val2;
+  int32_t tare;
+};
+
+/** @brief 교정 기본값으로 초기화 (setup 에서, 저장값 복원 전) */
+void measureBegin();
+
+/** @brief 교정 표 복사 / 교체 (설정 저장소) */
+void measureGetCal(MeasCal out[MEAS_KIND_COUNT][MEAS_UNITS]);
+void measureSetCal(const MeasCal in[MEAS_KIND_COUNT][MEAS_UNITS]);
+
+/** @brief 설정된 장비에 맞춰 채널 구성 (applySetting 에서) */
+void measureConfigure(const Setting& s);
+
+/** @brief 샘플링 + 필터 (fastTick, 인터럽트 컨텍스트) */
+void measureTick();
+
+/** @brief 그릇 감지 / 목표 무게 판정과 이벤트 (loop 에서) */
+void measurePoll();
+
+/** @brief 교정된 값 (g / mm). 구성 안 된 채널은 0 */
+int32_t measureValue(uint8_t kind, uint8_t unit);
+
+/** @brief 배출구 그릇 감지 상태 */
+bool measureBowlPresent(uint8_t unit);
+
+bool handleMeasureJson(JsonVariantConst doc);
+
+#endif // MEASURE_H
@@ -0,0 +1,239 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "motor.h"
+#include "txbuffer.h"
+#include "fastio.h"
+#include "evlog.h"
+
+static const char* const SHAPE_NAMES[] = { "step", "linear", "scurve" };
+static const uint8_t SHAPE_COUNT = 3;
+
+static MotorProfile profiles[ACT_COUNT] = {
+  { MOTOR_CUP_SHAPE,      MOTOR_CUP_RAMP_MS,      MOTOR_CUP_MIN_DUTY,      255, 0 },
+  { MOTOR_RAMEN_UP_SHAPE, MOTOR_RAMEN_UP_RAMP_MS, MOTOR_RAMEN_UP_MIN_DUTY,
+    MOTOR_RAMEN_UP_SLOW_DUTY, MOTOR_RAMEN_UP_SLOW_COUNTS },
+  { MOTOR_RAMEN_EJ_SHAPE, MOTOR_RAMEN_EJ_RAMP_MS, MOTOR_RAMEN_EJ_MIN_DUTY, 255, 0 },
+  { RAMP_STEP, 0, 255, 255, 0 },   // powder: 짧은 정량 배출이라 램프 없음
+  { MOTOR_OUTLET_SHAPE,   MOTOR_OUTLET_RAMP_MS,   MOTOR_OUTLET_MIN_DUTY,   255, 0 },
+  { RAMP_STEP, 0, 255, 255, 0 }    // cooker: 신호 출력
+};
+
+// 동시에 구동되는 모터 출력 (면 4대 x 리프트/배출 = 8 이 최대)
+const uint8_t MOTOR_CHANNELS = 12;
+const uint8_t NO_PIN = 0xFF;
+
+struct MotorChannel {
+  uint8_t pin = NO_PIN;   // NO_PIN = 빈 채널
+  bool pwm = false;       // false 면 HIGH 로만 구동
+  uint8_t shape = RAMP_STEP;
+  uint8_t duty = 0;
+  uint8_t from = 0;       // 램프 시작 duty
+  uint8_t to = 0;         // 램프 목표 duty
+  uint8_t act = 0;
+  uint16_t t = 0;         // 램프 진행 (tick)
+  uint16_t rampTicks = 0;
+};
+
+static MotorChannel channels[MOTOR_CHANNELS];
+
+static bool pinHasPwm(uint8_t pin) {
+#ifdef ARDUINO_ARCH_SAM
+  return (g_APinDescription[pin].ulPinAttribute & (PIN_ATTR_PWM | PIN_ATTR_TIMER)) != 0;
+#else
+  return pin >= 2 && pin <= 13;   // Due 의 analogWrite 가능 핀
+#endif
+}
+
+// 임계 구역: limitPoll() 처럼 이미 인터럽트를 막은 호출자 안에서도 불리므로
+// 무조건 interrupts() 하지 않고 이전 상태(PRIMASK)를 복원한다 (fastio.cpp 와 같은 방식)
+// (호스트 빌드는 host/Arduino.h 의 PRIMASK 흉내를 쓴다)
+static inline uint32_t irqSave() {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  return primask;
+}
+
+static inline void irqRestore(uint32_t primask) {
+  __set_PRIMASK(primask);
+}
+
+static MotorChannel* findChannel(uint8_t pin) {
+  for (uint8_t n = 0; n < MOTOR_CHANNELS; n++) {
+    if (channels[n].pin == pin) return &channels[n];
+  }
+  return nullptr;
+}
+
+static uint16_t msToTicks(uint16_t ms) {
+  return (uint16_t)((uint32_t)ms * FAST_TICK_HZ / 1000);
+}
+
+static void beginRamp(MotorChannel& c, uint8_t to, uint16_t rampMs) {
+  c.from = c.duty;
+  c.to = to;
+  c.t = 0;
+  c.rampTicks = msToTicks(rampMs);
+  if (c.rampTicks == 0) {
+    c.duty = to;
+    analogWrite(c.pin, to);
+  }
+}
+
+const MotorProfile& motorProfile(uint8_t act) {
+  return profiles[act];
+}
+
+void motorSetProfile(uint8_t act, const MotorProfile& p) {
+  if (act >= ACT_COUNT) return;
+  uint32_t primask = irqSave();
+  profiles[act] = p;
+  irqRestore(primask);
+}
+
+void motorStart(uint8_t act, uint8_t pin) {
+  const MotorProfile& p = profiles[act];
+  evlogPut(EV_MOTOR_START, pin, act);
+  uint32_t primask = irqSave();
+  MotorChannel* c = findChannel(pin);
+  if (c == nullptr) c = findChannel(NO_PIN);
+  if (c == nullptr) {   // 채널 부족: 램프 없이 구동
+    fioWrite(pin, HIGH);
+    irqRestore(primask);
+    return;
+  }
+  bool running = (c->pin == pin);
+  c->pin = pin;
+  c->act = act;
+  c->shape = p.shape;
+  c->pwm = (p.shape != RAMP_STEP) && pinHasPwm(pin);
+  if (!c->pwm) {
+    c->duty = 255;
+    c->rampTicks = 0;
+    fioWrite(pin, HIGH);
+  } else {
+    if (!running) {
+      c->duty = p.minDuty;
+      analogWrite(pin, c->duty);
+      fioShadow(pin, true);
+    }
+    beginRamp(*c, 255, p.rampMs);
+  }
+  irqRestore(primask);
+}
+
+void motorSlow(uint8_t pin) {
+  uint32_t primask = irqSave();
+  MotorChannel* c = findChannel(pin);
+  if (c != nullptr && c->pwm) {
+    uint8_t slow = profiles[c->act].slowDuty;
+    if (c->to != slow) beginRamp(*c, slow, profiles[c->act].rampMs);
+  }
+  irqRestore(primask);
+}
+
+void motorStop(uint8_t pin) {
+  bool pwm = false;
+  uint32_t primask = irqSave();
+  MotorChannel* c = findChannel(pin);
+  if (c != nullptr || fioOutput(pin)) evlogPut(EV_MOTOR_STOP, pin, 0);   // 이미 꺼진 출력은 기록 안 함
+  if (c != nullptr) {
+    pwm = c->pwm;
+    if (pwm) {
+      analogWrite(pin, 0);
+      fioShadow(pin, false);
+    }
+    c->pin = NO_PIN;
+    c->duty = 0;
+  }
+  if (!pwm) fioWrite(pin, LOW);
+  irqRestore(primask);
+}
+
+bool motorOn(uint8_t pin) {
+  if (findChannel(pin) != nullptr) return true;
+  return fioOutput(pin);   // 채널 밖에서 켠 출력 (powder/cooker 등)
+}
+
+uint8_t motorDuty(uint8_t pin) {
+  const MotorChannel* c = findChannel(pin);
+  if (c != nullptr) return c->duty;
+  return fioOutput(pin) ? 255 : 0;
+}
+
+void motorReset() {
+  for (uint8_t n = 0; n < MOTOR_CHANNELS; n++) {
+    uint8_t pin = channels[n].pin;
+    if (pin != NO_PIN) motorStop(pin);
+  }
+}
+
+void motorTick() {
+  for (uint8_t n = 0; n < MOTOR_CHANNELS; n++) {
+    MotorChannel& c = channels[n];
+    if (c.pin == NO_PIN || !c.pwm || c.t >= c.rampTicks) continue;
+    c.t++;
+    int32_t x = (int32_t)c.t * 256 / c.rampTicks;               // 진행률 Q8
+    if (c.shape == RAMP_SCURVE) x = (x * x * (768 - 2 * x)) >> 16;
+    uint8_t duty = (uint8_t)(c.from + (((int32_t)c.to - c.from) * x >> 8));
+    if (duty != c.duty) {
+      c.duty = duty;
+      analogWrite(c.pin, duty);
+    }
+  }
+}
+
+// =======================================================
+// === {"device":"motor"} 명령
+// =======================================================
+
+static void replyProfile(uint8_t act) {
+  const MotorProfile& p = profiles[act];
+  StaticJsonDocument<192> doc;
+  doc["device"] = "motor";
+  doc["target"] = ACTUATOR_NAMES[act];
+  doc["shape"] = SHAPE_NAMES[p.shape];
+  doc["ramp"] = p.rampMs;
+  doc["min"] = p.minDuty;
+  doc["slow"] = p.slowDuty;
+  doc["slow_counts"] = p.slowCounts;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+bool handleMotorJson(JsonVariantConst doc) {
+  const char* func = doc["function"] | "status";
+  const char* targetName = doc["target"] | "";
+  int target = -1;
+  if (targetName[0] != '\0') {
+    target = actuatorFind(targetName);
+    if (target < 0) { TxEvent.println("unknown motor target"); return false; }
+  }
+
+  if (strcmp(func, "set") == 0) {
+    if (target < 0) { TxEvent.println("motor set needs target"); return false; }
+    MotorProfile& p = profiles[target];
+    const char* shape = doc["shape"] | "";
+    if (shape[0] != '\0') {
+      uint8_t s = 0;
+      while (s < SHAPE_COUNT && strcmp(shape, SHAPE_NAMES[s]) != 0) s++;
+      if (s == SHAPE_COUNT) { TxEvent.println("unknown motor shape"); return false; }
+      p.shape = s;
+    }
+    long ramp = doc["ramp"] | -1L;
+    long minDuty = doc["min"] | -1L;
+    long slow = doc["slow"] | -1L;
+    long slowCounts = doc["slow_counts"] | -1L;
+    if (ramp >= 0) p.rampMs = (uint16_t)constrain(ramp, 0L, 5000L);
+    if (minDuty >= 0) p.minDuty = (uint8_t)constrain(minDuty, 0L, 255L);
+    if (slow >= 0) p.slowDuty = (uint8_t)constrain(slow, 0L, 255L);
+    if (slowCounts >= 0) p.slowCounts = (uint16_t)constrain(slowCounts, 0L, 60000L);
+  } else if (strcmp(func, "status") != 0) {
+    TxEvent.println("unknown motor function");
+    return false;
+  }
+
+  for (uint8_t a = 0; a < ACT_COUNT; a++) {
+    if (target < 0 || target == a) replyProfile(a);
+  }
+  return true;
+}
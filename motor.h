@@ -0,0 +1,65 @@
+#ifndef MOTOR_H
+#define MOTOR_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "actuator.h"
+
+// =======================================================
+// === DC 모터 소프트 스타트 / 램프 프로파일
+// === - motorStart(): PWM 가능 핀(Due D2~D13, analogWrite)은 min duty 에서 255 까지
+// ===   램프(linear / S-curve)로 기동. 그 외 핀이나 shape=step 은 기존처럼 HIGH
+// === - 램프 진행은 fastTick(1kHz, tick.h) 에서 1 tick = 1ms 단위
+// === - motorSlow(): 감속 구간 진입 시 slow duty 까지 램프 다운 (엔코더가 있는 면 리프트)
+// === - motorStop(): 즉시 차단 (리밋 스위치/보호 기능은 감속 없이 끈다). 인터럽트에서도 사용
+// === - motorOn(): 출력 핀의 digitalRead 대신 사용 (PWM 중에는 핀 레벨이 토글됨)
+// === - 명령: {"device":"motor","function":"status|set","target":...}
+// ===   set 인자: shape (step|linear|scurve), ramp (ms), min, slow (duty 0~255), slow_counts
+// =======================================================
+
+enum RampShape : uint8_t {
+  RAMP_STEP = 0,    // 램프 없음 (ON/OFF)
+  RAMP_LINEAR,
+  RAMP_SCURVE       // smoothstep 3x^2 - 2x^3
+};
+
+struct MotorProfile {
+  uint8_t shape;        // RampShape
+  uint16_t rampMs;      // 가속/감속 시간
+  uint8_t minDuty;      // 기동 시작 duty (이 아래로는 모터가 돌지 않음)
+  uint8_t slowDuty;     // 감속 구간 duty
+  uint16_t slowCounts;  // 감속 구간 길이 (엔코더 count, 면 리프트만)
+};
+
+/** @brief 액추에이터 종류별 프로파일 */
+const MotorProfile& motorProfile(uint8_t act);
+
+/** @brief 프로파일 교체 (저장값 복원, 다음 기동부터 적용) */
+void motorSetProfile(uint8_t act, const MotorProfile& p);
+
+/** @brief 출력 핀 기동 (act 의 프로파일 사용) */
+void motorStart(uint8_t act, uint8_t pin);
+
+/** @brief 감속 구간: slow duty 까지 램프 다운 (이미 감속 중이면 무시) */
+void motorSlow(uint8_t pin);
+
+/** @brief 즉시 정지 */
+void motorStop(uint8_t pin);
+
+/** @brief 출력이 구동 중인지 */
+bool motorOn(uint8_t pin);
+
+/** @brief 현재 duty (0~255, ON/OFF 핀은 0 또는 255) */
+uint8_t motorDuty(uint8_t pin);
+
+/** @brief 모든 램프 채널 정지 (설정 변경 시) */
+void motorReset();
+
+/** @brief 램프 진행 (fastTick 에서 호출) */
+void motorTick();
+
+/** @brief {"device":"motor"} 명령 처리 */
+bool handleMotorJson(JsonVariantConst doc);
+
+#endif // MOTOR_H
@@ -0,0 +1,238 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <string.h>
+#include "nvconfig.h"
+#include "flash.h"
+#include "binproto.h"
+#include "state.h"
+#include "protocol.h"
+#include "protect.h"
+#include "motor.h"
+#include "measure.h"
+#include "txbuffer.h"
+
+const uint32_t CONFIG_MAGIC   = 0x47464342;   // "BCFG"
+const uint16_t CONFIG_VERSION = 1;            // 레코드 구조를 바꾸면 올릴 것 (이전 레코드는 무시 -> 기본값)
+
+struct ConfigRecord {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t length;        // sizeof(ConfigRecord), 빌드 간 구조 차이 검출
+  uint32_t seq;           // 저장 세대 (클수록 최신)
+  Setting setting;
+  uint8_t hasSetting;     // 저장 당시 장비 구성이 있었는지
+  Tuning tuning;
+  MotorProfile motor[ACT_COUNT];
+  ProtectLimits protect[ACT_COUNT][ACTUATOR_MAX_UNITS];
+  MeasCal measure[MEAS_KIND_COUNT][MEAS_UNITS];
+  uint16_t crc;           // 위 전체 (binCrc16)
+};
+
+const uint8_t CONFIG_SLOT_PAGES = (sizeof(ConfigRecord) + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
+const uint8_t CONFIG_SLOTS = FLASH_STORE_PAGES / CONFIG_SLOT_PAGES;
+static_assert(CONFIG_SLOTS >= 2, "config store needs at least two slots for wear levelling");
+
+static ConfigRecord scratch;     // 저장용 (스택 대신)
+static int8_t activeSlot = -1;   // 마지막으로 읽거나 쓴 슬롯 (-1 = 없음)
+static uint32_t activeSeq = 0;
+
+static const ConfigRecord* slotRecord(uint8_t slot) {
+  return (const ConfigRecord*)flashPage(slot * CONFIG_SLOT_PAGES);
+}
+
+static bool recordValid(const ConfigRecord* r) {
+  return r->magic == CONFIG_MAGIC && r->version == CONFIG_VERSION && r->length == sizeof(ConfigRecord) &&
+         r->crc == binCrc16((const uint8_t*)r, offsetof(ConfigRecord, crc));
+}
+
+// 유효한 슬롯 중 seq 최대 (없으면 -1)
+static int8_t findLatest() {
+  int8_t best = -1;
+  for (uint8_t i = 0; i < CONFIG_SLOTS; i++) {
+    const ConfigRecord* r = slotRecord(i);
+    if (!recordValid(r)) continue;
+    if (best < 0 || r->seq > slotRecord(best)->seq) best = i;
+  }
+  return best;
+}
+
+static bool anyDevice(const Setting& s) {
+  return s.cup || s.ramen || s.powder || s.cooker || s.outlet;
+}
+
+static void applyRecord(const ConfigRecord& r) {
+  tuning = r.tuning;
+  for (uint8_t a = 0; a < ACT_COUNT; a++) motorSetProfile(a, r.motor[a]);
+  protectSetLimits(r.protect);
+  measureSetCal(r.measure);
+
+  if (!r.hasSetting) return;
+  String why = "";
+  if (!validateRules(r.setting, why)) {   // 규칙이 바뀐 펌웨어: 구성은 호스트에 맡김
+    TxEvent.print("config: stored setting rejected: "); TxEvent.println(why.c_str());
+    return;
+  }
+  applySetting(r.setting);
+  replyCurrentSetting(current);
+}
+
+static void reportRestored(const char* event, const char* reason) {
+  StaticJsonDocument<160> doc;
+  doc["device"] = "config";
+  doc["event"] = event;
+  if (reason) {
+    doc["reason"] = reason;
+  } else {
+    doc["seq"] = activeSeq;
+    doc["slot"] = activeSlot;
+    doc["setting"] = slotRecord(activeSlot)->hasSetting != 0;
+  }
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+static bool restore(const char* event) {
+  int8_t slot = findLatest();
+  if (slot < 0) return false;
+  activeSlot = slot;
+  activeSeq = slotRecord(slot)->seq;
+  applyRecord(*slotRecord(slot));
+  reportRestored(event, nullptr);
+  return true;
+}
+
+void configBegin() {
+  if (restore("restored")) return;
+  // magic 이 있는데 무효 = 버전 변경 또는 쓰다 만 레코드
+  bool stale = false;
+  for (uint8_t i = 0; i < CONFIG_SLOTS; i++) {
+    if (slotRecord(i)->magic == CONFIG_MAGIC) stale = true;
+  }
+  reportRestored("defaults", stale ? "invalid" : "empty");
+}
+
+bool configSave() {
+  ConfigRecord& r = scratch;
+  memset((void*)&r, 0, sizeof(r));   // 패딩까지 0 (CRC 재현성)
+  r.magic = CONFIG_MAGIC;
+  r.version = CONFIG_VERSION;
+  r.length = sizeof(ConfigRecord);
+  r.seq = activeSeq + 1;
+  r.setting = current;
+  r.hasSetting = anyDevice(current) ? 1 : 0;
+  r.tuning = tuning;
+  for (uint8_t a = 0; a < ACT_COUNT; a++) r.motor[a] = motorProfile(a);
+  protectGetLimits(r.protect);
+  measureGetCal(r.measure);
+  r.crc = binCrc16((const uint8_t*)&r, offsetof(ConfigRecord, crc));
+
+  uint8_t slot = (uint8_t)((activeSlot + 1) % CONFIG_SLOTS);
+  if (!flashWrite(slot * CONFIG_SLOT_PAGES, &r, sizeof(r)) || !recordValid(slotRecord(slot))) {
+    TxEvent.println("config: flash write failed");
+    return false;
+  }
+  activeSlot = slot;
+  activeSeq = r.seq;
+
+  StaticJsonDocument<128> doc;
+  doc["device"] = "config";
+  doc["event"] = "saved";
+  doc["seq"] = activeSeq;
+  doc["slot"] = activeSlot;
+  doc["setting"] = r.hasSetting != 0;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+  return true;
+}
+
+// =======================================================
+// === {"device":"config"} 명령
+// =======================================================
+
+static void replyStatus() {
+  StaticJsonDocument<640> doc;
+  doc["device"] = "config";
+  doc["version"] = CONFIG_VERSION;
+  doc["bytes"] = sizeof(ConfigRecord);
+  doc["slots"] = CONFIG_SLOTS;
+  doc["slot"] = activeSlot;
+  doc["seq"] = activeSeq;
+  doc["publish_ms"] = tuning.publishMs;
+  JsonArray travel = doc.createNestedArray("rise_travel");
+  for (uint8_t i = 0; i < MAX_RAMEN; i++) travel.add(tuning.riseTravel[i]);
+  JsonObject motion = doc.createNestedObject("motion");
+  for (uint8_t a = 0; a < ACT_COUNT; a++) {
+    if (tuning.motionMaxMs[a] == 0) continue;
+    JsonArray t = motion.createNestedArray(ACTUATOR_NAMES[a]);   // [expected, max]
+    t.add(tuning.motionExpectedMs[a]);
+    t.add(tuning.motionMaxMs[a]);
+  }
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+// 전부 검사한 뒤 한 번에 반영 (중간에 거부되면 아무것도 바뀌지 않음)
+static bool setTuning(JsonVariantConst doc) {
+  Tuning t = tuning;
+
+  if (!doc["publish_ms"].isNull()) {
+    long ms = doc["publish_ms"] | 0L;
+    if (ms < 50 || ms > 60000) { TxEvent.println("config publish_ms range 50~60000"); return false; }
+    t.publishMs = (uint16_t)ms;
+  }
+
+  if (!doc["rise_travel"].isNull()) {
+    long travel = doc["rise_travel"] | 0L;
+    int control = doc["control"] | 0;
+    if (travel <= 0 || travel > 100000L) { TxEvent.println("config rise_travel range 1~100000"); return false; }
+    if (control < 0 || control > MAX_RAMEN) { TxEvent.println("invalid config control num"); return false; }
+    for (uint8_t i = 0; i < MAX_RAMEN; i++) {
+      if (control == 0 || control == i + 1) t.riseTravel[i] = travel;
+    }
+  }
+
+  const char* targetName = doc["target"] | "";
+  if (targetName[0] != '\0') {
+    int target = actuatorFind(targetName);
+    const Tuning defaults;
+    // powder/cooker 는 자체 타이머로 끝나므로 감시를 켤 수 없음
+    if (target < 0 || defaults.motionMaxMs[target] == 0) { TxEvent.println("config target has no motion watch"); return false; }
+    long maxMs = doc["max"] | (long)t.motionMaxMs[target];
+    long expected = doc["expected"] | (long)t.motionExpectedMs[target];
+    if (maxMs < 100 || maxMs > 60000 || expected < 0 || expected > maxMs) {
+      TxEvent.println("config motion needs 100<=max<=60000, 0<=expected<=max");
+      return false;
+    }
+    t.motionMaxMs[target] = (uint16_t)maxMs;
+    t.motionExpectedMs[target] = (uint16_t)expected;
+  }
+  tuning = t;
+  return true;
+}
+
+bool handleConfigJson(JsonVariantConst doc) {
+  const char* func = doc["function"] | "status";
+
+  if (strcmp(func, "save") == 0) {
+    return configSave();
+  } else if (strcmp(func, "load") == 0) {
+    if (!restore("loaded")) { TxEvent.println("config: nothing stored"); return false; }
+    return true;
+  } else if (strcmp(func, "erase") == 0) {
+    for (uint8_t i = 0; i < CONFIG_SLOTS; i++) {
+      if (slotRecord(i)->magic != CONFIG_MAGIC) continue;
+      if (!flashPageWrite(i * CONFIG_SLOT_PAGES, nullptr, 0)) { TxEvent.println("config: flash write failed"); return false; }
+    }
+    activeSlot = -1;
+    activeSeq = 0;
+    TxEvent.println("config: erased (defaults on next boot)");
+    return true;
+  } else if (strcmp(func, "set") == 0) {
+    if (!setTuning(doc)) return false;
+  } else if (strcmp(func, "status") != 0) {
+    TxEvent.println("unknown config function");
+    return false;
+  }
+  replyStatus();
+  return true;
+}
@@ -0,0 +1,32 @@
+#ifndef NVCONFIG_H
+#define NVCONFIG_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// =======================================================
+// === 설정 저장소 (내부 플래시, flash.h)
+// === - 레코드 하나 = Setting + tuning + 모터 프로파일 + 과전류 한계값 + 측정 교정
+// ===   magic / 버전 / 길이 / 세대(seq) / CRC16 으로 검증
+// === - 마모 분산: 저장 영역을 레코드 크기의 슬롯으로 나누고 저장할 때마다
+// ===   다음 슬롯에 seq+1 로 기록. 부팅 시 유효한 슬롯 중 seq 가 가장 큰 것을 사용
+// ===   (쓰는 도중 전원이 나가도 이전 슬롯이 남음)
+// === - setup() 에서 configBegin() 이 복원: 장비 구성까지 저장돼 있으면
+// ===   호스트의 setting 없이 바로 동작 가능
+// === - 명령: {"device":"config","function":"status|set|save|load|erase"}
+// ===   set: "publish_ms", "rise_travel"(+ "control"),
+// ===        "target" + "expected"/"max" (동작 감시 ms, 감시 대상 액추에이터만)
+// ===   save: 현재 장비 구성과 모든 파라미터를 저장 (명령으로만, 주기적으로 쓰지 말 것)
+// ===   load: 저장값 다시 적용, erase: 저장값 무효화 (다음 부팅부터 기본값)
+// === - 복원 이벤트: {"device":"config","event":"restored|defaults",...}
+// =======================================================
+
+/** @brief 저장된 레코드 복원 (setup 에서, 다른 모듈 초기화 후) */
+void configBegin();
+
+/** @brief 현재 구성/파라미터를 다음 슬롯에 저장 (결과는 TxEvent 로 보고) */
+bool configSave();
+
+bool handleConfigJson(JsonVariantConst doc);
+
+#endif // NVCONFIG_H
@@ -0,0 +1,67 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "profiler.h"
+#include "txbuffer.h"
+
+static const char* const PROF_STAGE_NAMES[PROF_STAGE_COUNT] = {
+  "adc", "cup", "ramen", "timer", "outlet", "rx", "publish", "tx", "loop"
+};
+
+static ProfHistogram profHist[PROF_STAGE_COUNT];
+
+static uint8_t bucketOf(uint32_t us) {
+  uint8_t k = 0;
+  while (us && k < PROF_BUCKETS - 1) { us >>= 1; k++; }
+  return k;
+}
+
+void profRecord(uint8_t stage, uint32_t us) {
+  ProfHistogram& h = profHist[stage];
+  if (h.count == 0 || us < h.minUs) h.minUs = us;
+  if (us > h.maxUs) h.maxUs = us;
+  h.count++;
+  h.bucket[bucketOf(us)]++;
+}
+
+void profReset() {
+  memset(profHist, 0, sizeof(profHist));
+}
+
+/**
+ * @brief 히스토그램에서 pct 백분위가 속한 버킷의 상한(us)을 반환 (max 로 제한)
+ */
+uint32_t profPercentile(uint8_t stage, uint8_t pct) {
+  const ProfHistogram& h = profHist[stage];
+  if (h.count == 0) return 0;
+  uint32_t target = (uint32_t)(((uint64_t)h.count * pct + 99) / 100);
+  uint32_t acc = 0;
+  for (uint8_t k = 0; k < PROF_BUCKETS; k++) {
+    acc += h.bucket[k];
+    if (acc >= target) {
+      uint32_t upper = (k == 0) ? 0 : ((1UL << k) - 1);
+      return upper < h.maxUs ? upper : h.maxUs;
+    }
+  }
+  return h.maxUs;
+}
+
+void replyProfilerStats() {
+#if LOOP_PROFILER
+  StaticJsonDocument<192> doc;
+  for (uint8_t s = 0; s < PROF_STAGE_COUNT; s++) {
+    const ProfHistogram& h = profHist[s];
+    doc.clear();
+    doc["device"] = "stats";
+    doc["stage"] = PROF_STAGE_NAMES[s];
+    doc["n"] = h.count;
+    doc["min"] = h.minUs;
+    doc["max"] = h.maxUs;
+    doc["p50"] = profPercentile(s, 50);
+    doc["p99"] = profPercentile(s, 99);
+    serializeJson(doc, TxEvent);
+    TxEvent.println();
+  }
+#else
+  TxEvent.println("profiler disabled");
+#endif
+}
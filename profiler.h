@@ -0,0 +1,54 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// =======================================================
+// === loop() 단계별 소요 시간 프로파일러
+// === micros() 차이를 log2 버킷 히스토그램에 누적하고
+// === min/max/p50/p99 를 {"device":"stats"} 로 보고한다.
+// =======================================================
+
+enum ProfStage : uint8_t {
+  PROF_ADC = 0,     // 비 SAM 빌드의 ADC 스캔 (SAM 은 DMA 라 0 에 가까움)
+  PROF_CUP,
+  PROF_RAMEN,
+  PROF_TIMER,       // 타이머 휠 콜백 (스프/쿠커 종료, 발행 주기, 동작 감시 마감)
+  PROF_OUTLET,
+  PROF_RX,
+  PROF_PUBLISH,
+  PROF_TX,
+  PROF_LOOP,       // loop() 1회 전체
+  PROF_STAGE_COUNT
+};
+
+// 버킷 k : [2^(k-1), 2^k) us  (k=0 은 0us), 마지막 버킷은 그 이상 전부
+const uint8_t PROF_BUCKETS = 24;
+
+struct ProfHistogram {
+  uint32_t count;
+  uint32_t minUs;
+  uint32_t maxUs;
+  uint32_t bucket[PROF_BUCKETS];
+};
+
+void profRecord(uint8_t stage, uint32_t us);
+void profReset();
+uint32_t profPercentile(uint8_t stage, uint8_t pct);
+void replyProfilerStats();
+
+#if LOOP_PROFILER
+// 단계 시작 시각을 기록하고, PROF_STAGE 마다 직전 시각부터의 경과를 누적
+#define PROF_BEGIN()     uint32_t _profLoopUs = micros(); uint32_t _profMarkUs = _profLoopUs
+#define PROF_STAGE(st)   do { uint32_t _n = micros(); profRecord((st), _n - _profMarkUs); _profMarkUs = _n; } while (0)
+#define PROF_SKIP()      (_profMarkUs = micros())
+#define PROF_END()       profRecord(PROF_LOOP, micros() - _profLoopUs)
+#else
+#define PROF_BEGIN()     do { } while (0)
+#define PROF_STAGE(st)   do { } while (0)
+#define PROF_SKIP()      do { } while (0)
+#define PROF_END()       do { } while (0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,284 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <string.h>
+#include "protect.h"
+#include "adc.h"
+#include "motor.h"
+#include "supervisor.h"
+#include "cooker.h"
+#include "txbuffer.h"
+#include "evlog.h"
+
+// =======================================================
+// === 채널 / 한계값
+// =======================================================
+
+const uint8_t PROTECT_MAX_CHANNELS = 8;   // 허용되는 장비 조합 중 최대 (ramen 4 x 2, powder 8, cup+cooker)
+const uint8_t PROTECT_I2T_COOL_SHIFT = 7; // nominal 이하일 때 tick 마다 1/128 씩 감소 (약 128ms 시정수)
+
+// I²t 는 tick 마다 (초과분)² 을 더하므로 단위가 ms 가 되려면 1 tick = 1ms 여야 함
+static_assert(FAST_TICK_HZ == 1000, "protect: I2T accumulates per tick in ms units");
+
+enum ProtectTrip : uint8_t {
+  TRIP_NONE = 0,
+  TRIP_INSTANT,
+  TRIP_I2T
+};
+
+struct ProtectChannel {
+  uint8_t target;              // ActuatorId
+  uint8_t unit;
+  uint8_t ain;
+  uint8_t out[2];
+  uint8_t outCount;
+  bool wasOn;
+  uint16_t blankTicks;
+  uint32_t i2t;
+  uint16_t peak;               // 켜져 있는 동안 최대 전류 (꺼질 때 evlog 에 기록)
+  volatile uint8_t tripped;    // ProtectTrip
+  volatile uint16_t tripAmp;   // 차단 시점 전류
+  volatile bool pendingReport;
+  volatile bool pendingBlocked;   // 래치 중 다시 켜려는 시도를 끊음
+};
+
+// 한계값은 장비 재설정 후에도 유지 (target x unit)
+static ProtectLimits limits[ACT_COUNT][ACTUATOR_MAX_UNITS];
+static ProtectChannel channels[PROTECT_MAX_CHANNELS];
+static volatile uint8_t channelCount = 0;
+static bool limitsReady = false;
+
+// 모터가 아닌 부하의 기본 한계값 (최초 1회, 이후 set 명령 값 유지)
+static void initLimits() {
+  for (uint8_t u = 0; u < ACTUATOR_MAX_UNITS; u++) {
+    limits[ACT_COOKER][u].tripAmp = PROTECT_COOKER_TRIP_AMP;
+    limits[ACT_COOKER][u].nominalAmp = PROTECT_COOKER_NOMINAL_AMP;
+  }
+  limitsReady = true;
+}
+
+static void addChannel(uint8_t act, uint8_t unit) {
+  if (channelCount >= PROTECT_MAX_CHANNELS) return;
+  ProtectChannel& c = channels[channelCount];
+  c.target = act;
+  c.unit = unit;
+  c.ain = actuatorCurrentPin(act, unit);
+  c.outCount = actuatorOutputs(act, unit, c.out);   // tick 에서 빠르게 쓰도록 복사
+  c.wasOn = false;
+  c.blankTicks = 0;
+  c.i2t = 0;
+  c.peak = 0;
+  c.tripped = TRIP_NONE;
+  c.tripAmp = 0;
+  c.pendingReport = false;
+  c.pendingBlocked = false;
+  channelCount = channelCount + 1;
+}
+
+void protectConfigure(const Setting& s) {
+  if (!limitsReady) initLimits();
+  noInterrupts();
+  channelCount = 0;
+  for (uint8_t i = 0; i < s.cup; i++) addChannel(ACT_CUP, i);
+  for (uint8_t i = 0; i < s.ramen; i++) {
+    addChannel(ACT_RAMEN_UP, i);
+    addChannel(ACT_RAMEN_EJ, i);
+  }
+  for (uint8_t i = 0; i < s.powder; i++) addChannel(ACT_POWDER, i);
+  for (uint8_t i = 0; i < s.outlet; i++) addChannel(ACT_OUTLET, i);
+  // cooker 3, 4번은 출력 핀이 없어 감시만
+  for (uint8_t i = 0; i < s.cooker; i++) addChannel(ACT_COOKER, i);
+  interrupts();
+}
+
+void protectGetLimits(ProtectLimits out[ACT_COUNT][ACTUATOR_MAX_UNITS]) {
+  if (!limitsReady) initLimits();
+  memcpy(out, limits, sizeof(limits));
+}
+
+void protectSetLimits(const ProtectLimits in[ACT_COUNT][ACTUATOR_MAX_UNITS]) {
+  noInterrupts();
+  memcpy(limits, in, sizeof(limits));
+  limitsReady = true;
+  interrupts();
+}
+
+// =======================================================
+// === tick (인터럽트 컨텍스트)
+// =======================================================
+
+static void cut(ProtectChannel& c) {
+  for (uint8_t k = 0; k < c.outCount; k++) motorStop(c.out[k]);
+}
+
+static void trip(ProtectChannel& c, uint8_t reason, int amp) {
+  cut(c);
+  evlogPut(EV_TRIP, EV_TARGET(c.target, c.unit), (uint16_t)amp);
+  c.peak = 0;
+  c.tripped = reason;
+  c.tripAmp = (uint16_t)amp;
+  c.pendingReport = true;
+}
+
+void protectTick() {
+  for (uint8_t n = 0; n < channelCount; n++) {
+    ProtectChannel& c = channels[n];
+    const ProtectLimits& lim = limits[c.target][c.unit];
+
+    bool on = false;
+    for (uint8_t k = 0; k < c.outCount; k++) {
+      if (motorOn(c.out[k])) on = true;
+    }
+    if (c.tripped) {            // 래치: 다시 켜면 즉시 끔
+      if (on) {
+        cut(c);
+        c.pendingBlocked = true;
+      }
+      continue;
+    }
+    if (!lim.enabled) {
+      c.wasOn = on;
+      c.i2t = 0;
+      continue;
+    }
+
+    int amp = adcRead(c.ain);
+    if (on && !c.wasOn) c.blankTicks = (uint16_t)((uint32_t)lim.blankMs * FAST_TICK_HZ / 1000);
+    if (!on && c.wasOn) {
+      evlogPut(EV_PEAK, EV_TARGET(c.target, c.unit), c.peak);
+      c.peak = 0;
+    }
+    c.wasOn = on;
+    if (on && amp > (int)c.peak) c.peak = (uint16_t)amp;
+
+    if (c.blankTicks) {
+      c.blankTicks--;
+    } else if (on && amp > (int)lim.tripAmp) {
+      trip(c, TRIP_INSTANT, amp);
+      continue;
+    }
+
+    int32_t excess = amp - (int32_t)lim.nominalAmp;
+    if (excess > 0) {
+      uint32_t add = (uint32_t)excess * (uint32_t)excess;
+      c.i2t = (c.i2t > UINT32_MAX - add) ? UINT32_MAX : c.i2t + add;   // 감싸지 않고 포화
+      if (c.i2t > lim.i2tLimit) trip(c, TRIP_I2T, amp);
+    } else {
+      c.i2t -= c.i2t >> PROTECT_I2T_COOL_SHIFT;
+    }
+  }
+}
+
+// =======================================================
+// === loop 측: 보고 / 명령
+// =======================================================
+
+static const char* tripName(uint8_t t) {
+  return t == TRIP_INSTANT ? "instant" : (t == TRIP_I2T ? "i2t" : "none");
+}
+
+void protectPoll() {
+  for (uint8_t n = 0; n < channelCount; n++) {
+    ProtectChannel& c = channels[n];
+    if (!c.pendingReport && !c.pendingBlocked) continue;
+    bool first = c.pendingReport;
+    c.pendingReport = false;
+    c.pendingBlocked = false;
+    if (first) {
+      motionAbort(c.target, c.unit);
+      if (c.target == ACT_COOKER) cookerAbort(c.unit);   // 단계 타이머를 기다리지 않고 중단
+    }
+
+    StaticJsonDocument<192> doc;
+    doc["device"] = "protect";
+    doc["event"] = first ? "trip" : "blocked";
+    doc["target"] = ACTUATOR_NAMES[c.target];
+    doc["control"] = c.unit + 1;
+    doc["reason"] = tripName(c.tripped);
+    doc["amp"] = c.tripAmp;
+    serializeJson(doc, TxEvent);
+    TxEvent.println();
+  }
+}
+
+bool protectTripped(uint8_t act, uint8_t unit) {
+  for (uint8_t n = 0; n < channelCount; n++) {
+    if (channels[n].target == act && channels[n].unit == unit && channels[n].tripped) return true;
+  }
+  return false;
+}
+
+static void replyChannel(const ProtectChannel& c) {
+  const ProtectLimits& lim = limits[c.target][c.unit];
+  StaticJsonDocument<320> doc;
+  doc["device"] = "protect";
+  doc["target"] = ACTUATOR_NAMES[c.target];
+  doc["control"] = c.unit + 1;
+  doc["amp"] = adcRead(c.ain);
+  doc["i2t"] = c.i2t;
+  doc["tripped"] = tripName(c.tripped);
+  doc["enabled"] = lim.enabled;
+  doc["trip"] = lim.tripAmp;
+  doc["nominal"] = lim.nominalAmp;
+  doc["i2t_limit"] = lim.i2tLimit;
+  doc["blank"] = lim.blankMs;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+// target/control 필터 (target 생략 = 전체, control 생략 = 해당 target 전체)
+static bool matches(int target, int control, uint8_t t, uint8_t unit) {
+  return (target < 0 || target == t) && (control <= 0 || control == unit + 1);
+}
+
+bool handleProtectJson(JsonVariantConst doc) {
+  const char* func = doc["function"] | "status";
+  const char* targetName = doc["target"] | "";
+  int control = doc["control"] | 0;
+  int target = -1;
+  if (targetName[0] != '\0') {
+    target = actuatorFind(targetName);
+    if (target < 0) { TxEvent.println("unknown protect target"); return false; }
+  }
+
+  if (strcmp(func, "set") == 0) {
+    if (target < 0) { TxEvent.println("protect set needs target"); return false; }
+    if (control < 0 || control > ACTUATOR_MAX_UNITS) { TxEvent.println("invalid protect control num"); return false; }
+    long trip = doc["trip"] | -1L;
+    long nominal = doc["nominal"] | -1L;
+    long i2t = doc["i2t_limit"] | -1L;
+    long blank = doc["blank"] | -1L;
+    if (!doc["i2t_limit"].isNull() && (i2t < 1 || i2t > (long)PROTECT_I2T_LIMIT_MAX)) {
+      TxEvent.println("protect i2t_limit range 1~1000000000");
+      return false;
+    }
+    for (uint8_t u = 0; u < ACTUATOR_MAX_UNITS; u++) {
+      if (!matches(target, control, (uint8_t)target, u)) continue;
+      ProtectLimits& lim = limits[target][u];
+      noInterrupts();
+      if (trip >= 0) lim.tripAmp = (uint16_t)constrain(trip, 0L, 1023L);
+      if (nominal >= 0) lim.nominalAmp = (uint16_t)constrain(nominal, 0L, 1023L);
+      if (i2t >= 0) lim.i2tLimit = (uint32_t)i2t;
+      if (blank >= 0) lim.blankMs = (uint16_t)constrain(blank, 0L, 5000L);
+      if (doc["enabled"].is<bool>()) lim.enabled = doc["enabled"].as<bool>();
+      interrupts();
+    }
+  } else if (strcmp(func, "reset") == 0) {
+    for (uint8_t n = 0; n < channelCount; n++) {
+      ProtectChannel& c = channels[n];
+      if (!matches(target, control, c.target, c.unit)) continue;
+      noInterrupts();
+      c.tripped = TRIP_NONE;
+      c.i2t = 0;
+      c.wasOn = false;
+      interrupts();
+    }
+  } else if (strcmp(func, "status") != 0) {
+    TxEvent.println("unknown protect function");
+    return false;
+  }
+
+  for (uint8_t n = 0; n < channelCount; n++) {
+    if (matches(target, control, channels[n].target, channels[n].unit)) replyChannel(channels[n]);
+  }
+  return true;
+}
@@ -0,0 +1,55 @@
+#ifndef PROTECT_H
+#define PROTECT_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "state.h"
+#include "actuator.h"
+
+// =======================================================
+// === 모터 과전류 보호
+// === - 설정된 장비의 전류 채널마다 FAST_TICK_HZ 로 평가 (tick.h, 인터럽트 컨텍스트)
+// === - 즉시 차단: 출력이 켜진 뒤 블랭킹(blank ms) 이후 전류 > trip
+// === - I²t: (전류 - nominal)² 를 ms 단위로 누적, i2t_limit 초과 시 차단.
+// ===   nominal 이하일 때는 지수적으로 냉각
+// === - 차단되면 해당 출력(FWD/REV 등)을 LOW 로 내리고 래치.
+// ===   래치 중에는 출력이 다시 켜져도 다음 tick 에 끈다 (reset 으로 해제)
+// === - 명령: {"device":"protect","function":"status|set|reset", "target":..., "control":...}
+// ===   target: ACTUATOR_NAMES (cup | ramen_up | ramen_ej | powder | outlet | cooker)
+// ===   set 인자: trip, nominal, i2t_limit(1~PROTECT_I2T_LIMIT_MAX), blank, enabled (생략한 값은 유지)
+// === - 차단 이벤트: {"device":"protect","event":"trip","target":..,"control":..,"reason":"instant|i2t","amp":..}
+// ===   래치 중 켜려는 시도를 끊었을 때는 "event":"blocked"
+// =======================================================
+
+// 액추에이터 x 장비별 한계값 (장비 재설정 후에도 유지, nvconfig.h 가 저장)
+struct ProtectLimits {
+  uint16_t tripAmp = PROTECT_TRIP_AMP;
+  uint16_t nominalAmp = PROTECT_NOMINAL_AMP;
+  uint32_t i2tLimit = PROTECT_I2T_LIMIT;
+  uint16_t blankMs = PROTECT_BLANK_MS;
+  bool enabled = true;
+};
+
+/** @brief 설정된 장비 수에 맞춰 감시 채널 목록 재구성 (applySetting 에서 호출, 래치 해제) */
+void protectConfigure(const Setting& s);
+
+/** @brief 채널 평가 (fastTick 에서 호출) */
+void protectTick();
+
+/** @brief 새로 차단된 채널을 이벤트로 보고 (loop 에서 호출) */
+void protectPoll();
+
+/** @brief 해당 장비가 과전류로 래치되어 있는지 */
+bool protectTripped(uint8_t act, uint8_t unit);
+
+/** @brief 한계값 표 복사 (저장용) */
+void protectGetLimits(ProtectLimits out[ACT_COUNT][ACTUATOR_MAX_UNITS]);
+
+/** @brief 한계값 표 교체 (저장값 복원) */
+void protectSetLimits(const ProtectLimits in[ACT_COUNT][ACTUATOR_MAX_UNITS]);
+
+/** @brief {"device":"protect"} 명령 처리 */
+bool handleProtectJson(JsonVariantConst doc);
+
+#endif // PROTECT_H
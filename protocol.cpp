@@ -1,24 +1,43 @@
 #include <Arduino.h>
 #include <ArduinoJson.h>
-#include "Protocol.h"  // 자신의 헤더
+#include "protocol.h"  // 자신의 헤더
 #include "config.h"    // 핀맵
-#include "state.h"     // 전역 변수(current, state) 사용
-
-// ===== 전역 상태 변수 (idx=0 장비 전용 상태) =====
-enum RamenEjectState {
+#include "state.h"     // 전역 변수(current, tuning) 사용
+#include "profiler.h"  // {"device":"stats"} 조회
+#include "txbuffer.h"  // 논블로킹 송신 (TxEvent)
+#include "rxframe.h"   // 수신 통계
+#include "dispatch.h"  // 명령 테이블
+#include "telemetry.h" // 설정 변경 시 키프레임 재전송
+#include "encoder.h"   // 면 리프트 엔코더
+#include "adc.h"       // 아날로그 채널별 필터
+#include "protect.h"   // 과전류 보호 채널 재구성
+#include "supervisor.h" // 동작 시간 감시
+#include "timerwheel.h" // 스프/쿠커 종료 타이머
+#include "motor.h"      // 소프트 스타트 / 감속
+#include "cooker.h"     // 쿠커 조리 시퀀스
+#include "recipe.h"     // 주문 레시피 큐
+#include "limit.h"      // 리밋 스위치 인터럽트
+#include "fastio.h"     // PIO 레지스터 I/O
+#include "measure.h"    // 로드셀/초음파 채널 재구성
+#include "evlog.h"      // 이벤트 기록기
+
+// ===== 면 배출 상태 머신 (장비별) =====
+enum RamenEjectState : uint8_t {
   EJECT_IDLE,
-  EJECTING,
-  EJECT_RETURNING
+  EJECTING,          // 배출 전진, RAMEN_EJ_TOP_IN 대기
+  EJECT_RETURNING,   // 배출 복귀, RAMEN_EJ_BTM_IN 대기
+  EJECT_FAULT        // 동작 감시가 정지시킴. stopdispense 로 해제
+};
+
+struct RamenUnit {
+  RamenEjectState eject = EJECT_IDLE;
+  int32_t riseStartCount = 0;       // 상승 시작 시 엔코더 값
 };
-RamenEjectState ramenEjectStatus = EJECT_IDLE;  
+RamenUnit ramenUnits[MAX_RAMEN];
 
 bool isPowderDispensing[MAX_POWDER] = {false};
-unsigned long powderStartTime[MAX_POWDER] = {0};
-unsigned long powderDuration[MAX_POWDER] = {0}; 
+static Timer powderTimers[MAX_POWDER];   // 배출 종료 시각
 
-volatile long cur_encoder1 = 0;  
-unsigned long start_encoder1 = 0;
-unsigned long interval = 1000;
 
 // =======================================================
 // === 1. 설정 (Setup) 및 파싱 (Parse) 함수
@@ -32,8 +51,10 @@ void replyCurrentSetting(const Setting& s) {
   if (s.powder) doc["powder"] = s.powder;
   if (s.cooker) doc["cooker"] = s.cooker;
   if (s.outlet) doc["outlet"] = s.outlet;
-  serializeJson(doc, Serial);
-  Serial.println();
+  doc["protocol"] = (s.protocol == PROTO_BINARY) ? "binary" : "json";
+  doc["telemetry"] = (s.telemetry == TELEMETRY_DELTA) ? "delta" : (s.telemetry == TELEMETRY_SUBSCRIBE ? "subscribe" : "full");
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
 }
 
 // ===== 핀모드 설정 (Count 기반 복구) =====
@@ -43,10 +64,12 @@ void setupCup(uint8_t n) {
     pinMode(CUP_ROT_IN[i], INPUT_PULLUP);
     pinMode(CUP_DISP_IN[i], INPUT);
     pinMode(CUP_STOCK_IN[i], INPUT);
+    adcSetFilter(CUP_CURR_AIN[i], ADC_FILTER_FAST);
   }
 }
 void setupRamen(uint8_t n) {
   for (uint8_t i = 0; i < n; i++) { 
+    ramenUnits[i] = RamenUnit();
     pinMode(RAMEN_UP_FWD_OUT[i], OUTPUT);
     pinMode(RAMEN_UP_REV_OUT[i], OUTPUT);
     pinMode(RAMEN_EJ_FWD_OUT[i], OUTPUT);
@@ -56,16 +79,17 @@ void setupRamen(uint8_t n) {
     pinMode(RAMEN_UP_TOP_IN[i], INPUT_PULLUP);
     pinMode(RAMEN_UP_BTM_IN[i], INPUT_PULLUP);
     pinMode(RAMEN_PRESENT_IN[i], INPUT_PULLUP);
+    adcSetFilter(RAMEN_UP_CURR_AIN[i], ADC_FILTER_FAST);
+    adcSetFilter(RAMEN_EJ_CURR_AIN[i], ADC_FILTER_FAST);
   }
 
-  // 🔴 [수정] 모든 RAMEN_ENCORDER 핀 설정 (i 인덱스 사용)
-  for (uint8_t i = 0; i < MAX_RAMEN * 2; i++) { 
-     pinMode(RAMEN_ENCORDER[i], INPUT_PULLUP); 
-  }
+  // 장비별 엔코더 A/B 핀 + 인터럽트 (encoder.cpp)
+  encoderBegin(n);
 }
 void setupPowder(uint8_t n) {
   for (uint8_t i = 0; i < n; i++) { 
     pinMode(POWDER_MOTOR_OUT[i], OUTPUT);
+    adcSetFilter(POWDER_CURR_AIN[i], ADC_FILTER_FAST);
   }
 }
 
@@ -75,17 +99,21 @@ void setupOutlet(uint8_t n) {
     pinMode(OUTLET_REV_OUT[i], OUTPUT);
     pinMode(OUTLET_OPEN_IN[i], INPUT_PULLUP);
     pinMode(OUTLET_CLOSE_IN[i], INPUT_PULLUP);
+    adcSetFilter(OUTLET_CURR_AIN[i], ADC_FILTER_FAST);
+    adcSetFilter(OUTLET_USONIC_AIN[i], ADC_FILTER_MEDIUM);
+    adcSetFilter(OUTLET_LOAD_AIN[i], ADC_FILTER_SLOW);
   }
 }
 void setupCooker(uint8_t n) {
   for (uint8_t i = 0; i < n; i++) { 
-    if (i < 2) {
+    if (COOKER_HAS_OUTPUT[i]) {
       pinMode(COOKER_IND_SIG[i], OUTPUT);
       pinMode(COOKER_WTR_SIG[i], OUTPUT);
     } else {
       pinMode(COOKER_IND_SIG[i], INPUT);
       pinMode(COOKER_WTR_SIG[i], INPUT);
     }
+    adcSetFilter(COOKER_CURR_AIN[i], ADC_FILTER_FAST);
   }
 }
 
@@ -109,12 +137,21 @@ bool validateRules(const Setting& s, String& why) {
 }
 
 void applySetting(const Setting& s) {
+  evlogPut(EV_SETTING, 0, (uint16_t)(s.cup | (s.ramen << 3) | (s.powder << 6) | (s.cooker << 10) | (s.outlet << 13)));
+  motorReset();   // 이전 설정의 램프 채널 해제 (핀이 장비 간에 겹침)
+  cookerReset();
+  recipeReset();  // 대기 중인 주문은 이전 장비 구성 기준
   if (s.cup) setupCup(s.cup);
   if (s.ramen) setupRamen(s.ramen);
   if (s.powder) setupPowder(s.powder);
   if (s.outlet) setupOutlet(s.outlet);
   if (s.cooker) setupCooker(s.cooker);
+  fioSync();      // pinMode 로 바뀐 출력 레벨을 그림자에 반영
   current = s;  // 전역 변수 'current'에 적용
+  protectConfigure(s);
+  limitConfigure(s);
+  measureConfigure(s);
+  telemetryReset();
 }
 
 // =======================================================
@@ -124,55 +161,68 @@ void applySetting(const Setting& s) {
 /**
  * @brief 🔴 [수정] 용기 배출을 시작 (idx 인자 받기)
  */
-void startCupDispense(uint8_t idx) {
-  Serial.print("명령: 용기 배출 시작 (장비: "); Serial.print(idx + 1); Serial.println(")");
-  digitalWrite(CUP_MOTOR_OUT[idx], HIGH);
+bool startCupDispense(uint8_t idx) {
+  TxEvent.print("명령: 용기 배출 시작 (장비: "); TxEvent.print(idx + 1); TxEvent.println(")");
+  if (!motionStart(ACT_CUP, idx)) return false;
+  motorStart(ACT_CUP, CUP_MOTOR_OUT[idx]);
+  return true;
+}
+
+/**
+ * @brief 용기 배출 강제 정지
+ */
+void stopCupDispense(uint8_t idx) {
+  motorStop(CUP_MOTOR_OUT[idx]);
+  motionStop(ACT_CUP, idx);
 }
 
 /**
- * @brief 🟢 [복구] 용기 배출 멈춤 조건을 확인 (모든 장비 순회)
+ * @brief 🟢 [복구] 용기 배출 완료 처리 (모든 장비 순회)
+ *        회전 감지(CUP_ROT_IN LOW)에서 모터 차단은 리밋 인터럽트가 이미 했음 (limit.h)
  */
 void checkCupDispense() {
   for (uint8_t i = 0; i < current.cup; i++) {
-    if (digitalRead(CUP_MOTOR_OUT[i]) == HIGH) {
-      if (digitalRead(CUP_ROT_IN[i]) == LOW) { 
-        Serial.print("완료: 용기 배출 중지 (장비: "); Serial.print(i + 1); Serial.println(")");
-        digitalWrite(CUP_MOTOR_OUT[i], LOW);
-      }
+    if (limitHit(LIMIT_CUP_ROT, i)) {
+      TxEvent.print("완료: 용기 배출 중지 (장비: "); TxEvent.print(i + 1); TxEvent.println(")");
+      motionDone(ACT_CUP, i);
     }
   }
 }
 
 /**
- * @brief 🔴 [수정] 면 상승을 시작 (idx 인자 추가 및 사용)
+ * @brief 면 상승을 시작 (시작 엔코더 값 기록)
  */
-void startRamenRise(uint8_t idx) {
-  Serial.print("명령: 면 상승 시작 (장비: "); Serial.print(idx + 1); Serial.println(")");
-  noInterrupts();  
-  start_encoder1 = cur_encoder1; // 🔴 [주의] 엔코더는 단일 변수만 사용
-  interrupts();
-  Serial.print("시작 엔코더 값: "); Serial.println(start_encoder1);
-  digitalWrite(RAMEN_UP_FWD_OUT[idx], HIGH);
+bool startRamenRise(uint8_t idx) {
+  TxEvent.print("명령: 면 상승 시작 (장비: "); TxEvent.print(idx + 1); TxEvent.println(")");
+  if (!motionStart(ACT_RAMEN_UP, idx)) return false;
+  ramenUnits[idx].riseStartCount = encoderRead(idx);
+  TxEvent.print("시작 엔코더 값: "); TxEvent.println(ramenUnits[idx].riseStartCount);
+  motorStart(ACT_RAMEN_UP, RAMEN_UP_FWD_OUT[idx]);
+  return true;
 }
 
 /**
- * @brief 🟢 [복구] 면 상승 멈춤 조건 3가지를 확인 (모든 장비 순회)
+ * @brief 면 상승 멈춤 조건 3가지를 확인 (모든 장비 순회)
+ *        이동량 한계(tuning.riseTravel) / 면 감지 / 상한 스위치(리밋 인터럽트가 차단)
+ *        이동량 한계 slow_counts 앞부터 감속 (motor.h)
  */
 void checkRamenRise() {
   for (uint8_t i = 0; i < current.ramen; i++) { 
-    if (digitalRead(RAMEN_UP_FWD_OUT[i]) == HIGH) {
-      bool stopMotor = false;
-      // 🔴 [주의] 엔코더 로직은 i=0 장비에만 해당
-      if (i == 0) { 
-          long current_encoder_safe; noInterrupts(); current_encoder_safe = cur_encoder1; interrupts();
-          if (current_encoder_safe - start_encoder1 > interval) { stopMotor = true; }
+    bool top = limitHit(LIMIT_RAMEN_UP_TOP, i);
+    if (top || motorOn(RAMEN_UP_FWD_OUT[i])) {
+      bool stopMotor = top;
+      int32_t travel = encoderRead(i) - ramenUnits[i].riseStartCount;
+      if (!top && travel > tuning.riseTravel[i] - motorProfile(ACT_RAMEN_UP).slowCounts) {
+        motorSlow(RAMEN_UP_FWD_OUT[i]);
       }
-      if (digitalRead(RAMEN_PRESENT_IN[i]) == LOW) { stopMotor = true; } 
-      else if (digitalRead(RAMEN_UP_TOP_IN[i]) == HIGH) { stopMotor = true; } 
+      if (travel > tuning.riseTravel[i]) { stopMotor = true; }
+      else if (fioRead(RAMEN_PRESENT_IN[i]) == LOW) { stopMotor = true; } 
       
       if (stopMotor) {
-        Serial.print("완료: 상승 동작 중지 (장비: "); Serial.print(i + 1); Serial.println(")");
-        digitalWrite(RAMEN_UP_FWD_OUT[i], LOW);
+        TxEvent.print("완료: 상승 동작 중지 (장비: "); TxEvent.print(i + 1);
+        TxEvent.print(", 이동: "); TxEvent.print(travel); TxEvent.println(")");
+        motorStop(RAMEN_UP_FWD_OUT[i]);
+        motionDone(ACT_RAMEN_UP, i);
       }
     }
   }
@@ -181,292 +231,265 @@ void checkRamenRise() {
 /**
  * @brief 🔴 [수정] 면 하강(초기화)을 시작 (idx 인자 추가 및 사용)
  */
-void startRamenInit(uint8_t idx) {
-  Serial.print("명령: 면 하강 시작 (장비: "); Serial.print(idx + 1); Serial.println(")");
-  digitalWrite(RAMEN_UP_REV_OUT[idx], HIGH);
+bool startRamenInit(uint8_t idx) {
+  TxEvent.print("명령: 면 하강 시작 (장비: "); TxEvent.print(idx + 1); TxEvent.println(")");
+  if (!motionStart(ACT_RAMEN_UP, idx)) return false;
+  motorStart(ACT_RAMEN_UP, RAMEN_UP_REV_OUT[idx]);
+  return true;
 }
 
 /**
- * @brief 🟢 [복구] 면 하강(초기화) 멈춤 조건을 확인 (모든 장비 순회)
+ * @brief 🟢 [복구] 면 하강(초기화) 감속 및 완료 처리 (모든 장비 순회)
+ *        원점(엔코더 0) slow_counts 위부터 감속. 원점을 잡기 전에는 처음부터 감속
+ *        하한 스위치에서 모터 차단은 리밋 인터럽트가 함
  */
 void checkRamenInit() {
   for (uint8_t i = 0; i < current.ramen; i++) { 
-    if (digitalRead(RAMEN_UP_REV_OUT[i]) == HIGH) {
-      if (digitalRead(RAMEN_UP_BTM_IN[i]) == HIGH) {
-        Serial.print("완료: 하강 동작 중지 (장비: "); Serial.print(i + 1); Serial.println(")");
-        digitalWrite(RAMEN_UP_REV_OUT[i], LOW);
-      }
+    if (motorOn(RAMEN_UP_REV_OUT[i]) &&
+        encoderRead(i) < (int32_t)motorProfile(ACT_RAMEN_UP).slowCounts) {
+      motorSlow(RAMEN_UP_REV_OUT[i]);
+    }
+    if (limitHit(LIMIT_RAMEN_UP_BTM, i)) {
+      TxEvent.print("완료: 하강 동작 중지 (장비: "); TxEvent.print(i + 1); TxEvent.println(")");
+      motionDone(ACT_RAMEN_UP, i);
+      encoderWrite(i, 0);   // 하한 = 리프트 원점
     }
   }
 }
 
 /**
- * @brief 🔴 [수정] 면 배출을 시작 (idx 인자 추가 및 사용)
+ * @brief 면 배출을 시작 (장비별 상태 머신, IDLE 일 때만)
  */
-void startRamenEject(uint8_t idx) {
-  // 🔴 [주의] 상태 머신은 단일 변수이므로, idx=0일 때만 작동
-  if (idx == 0) { 
-      if (ramenEjectStatus == EJECT_IDLE) {
-          Serial.print("명령: 면 배출 시작 (장비: "); Serial.print(idx + 1); Serial.println(")");
-          ramenEjectStatus = EJECTING;
-          digitalWrite(RAMEN_EJ_FWD_OUT[idx], HIGH);
-      } else {
-          Serial.print("Warning: Eject command ignored. Status is not IDLE.");
-      }
-  } else {
-      // 2번 장비 이후는 상태머신 없이 즉시 동작 (단순 ON)
-      digitalWrite(RAMEN_EJ_FWD_OUT[idx], HIGH);
+bool startRamenEject(uint8_t idx) {
+  RamenUnit& u = ramenUnits[idx];
+  if (u.eject == EJECT_IDLE) {
+    TxEvent.print("명령: 면 배출 시작 (장비: "); TxEvent.print(idx + 1); TxEvent.println(")");
+    if (!motionStart(ACT_RAMEN_EJ, idx)) return false;
+    u.eject = EJECTING;
+    motorStop(RAMEN_EJ_REV_OUT[idx]);
+    motorStart(ACT_RAMEN_EJ, RAMEN_EJ_FWD_OUT[idx]);
+    return true;
   }
+  TxEvent.print("Warning: Eject command ignored. Status is not IDLE (장비: ");
+  TxEvent.print(idx + 1); TxEvent.println(")");
+  return false;
 }
 
 /**
- * @brief 🟢 [복구] 면 배출 상태 머신을 처리 (모든 장비 순회)
+ * @brief 면 배출 상태 머신을 처리 (모든 장비 순회, 논블로킹)
+ *        단계별 시간 초과는 동작 감시(supervisor)가 출력을 끊고 보고한다.
+ *        감시 슬롯이 RUNNING 이 아니면 (시간 초과 / 과전류 차단) FAULT 로 멈춘다.
  */
 void checkRamenEject() {
-  // 1. 상태 머신 (idx=0 전용)
-  if (current.ramen > 0) {
-      switch (ramenEjectStatus) {
-          case EJECTING:
-              if (digitalRead(RAMEN_EJ_TOP_IN[0]) == HIGH) { 
-                  Serial.println("상태: 배출 상한 도달. 복귀 시작 (장비: 1)");
-                  digitalWrite(RAMEN_EJ_FWD_OUT[0], LOW);
-                  digitalWrite(RAMEN_EJ_REV_OUT[0], HIGH);
-                  ramenEjectStatus = EJECT_RETURNING;
-              }
-              break;
-          case EJECT_RETURNING:
-              if (digitalRead(RAMEN_UP_BTM_IN[0]) == HIGH) { 
-                  Serial.println("완료: 상승 하한 감지. 배출 복귀 모터 정지 (장비: 1)");
-                  digitalWrite(RAMEN_EJ_REV_OUT[0], LOW);
-                  ramenEjectStatus = EJECT_IDLE;
-              }
-              break;
-          default: break;
-      }
-  }
-  
-  // 2. 단순 감시 (idx > 0 포함 모든 장비)
-  for (uint8_t i = 0; i < current.ramen; i++) { 
-    if (digitalRead(RAMEN_EJ_FWD_OUT[i]) == HIGH && digitalRead(RAMEN_EJ_TOP_IN[i]) == HIGH) {
-        digitalWrite(RAMEN_EJ_FWD_OUT[i], LOW);
+  for (uint8_t i = 0; i < current.ramen; i++) {
+    RamenUnit& u = ramenUnits[i];
+    if ((u.eject == EJECTING || u.eject == EJECT_RETURNING) &&
+        motionState(ACT_RAMEN_EJ, i) != MOTION_RUNNING) {
+      motorStop(RAMEN_EJ_FWD_OUT[i]);
+      motorStop(RAMEN_EJ_REV_OUT[i]);
+      TxEvent.print("오류: "); TxEvent.print(u.eject == EJECTING ? "배출 상한" : "배출 하한");
+      TxEvent.print(" 미도달. 배출 모터 정지 (장비: "); TxEvent.print(i + 1); TxEvent.println(")");
+      u.eject = EJECT_FAULT;
+      continue;
     }
-    if (digitalRead(RAMEN_EJ_REV_OUT[i]) == HIGH && digitalRead(RAMEN_EJ_BTM_IN[i]) == HIGH) {
-        digitalWrite(RAMEN_EJ_REV_OUT[i], LOW);
+    switch (u.eject) {
+      case EJECTING:
+        if (limitHit(LIMIT_RAMEN_EJ_TOP, i)) {   // 전진 출력은 인터럽트에서 이미 차단
+          TxEvent.print("상태: 배출 상한 도달. 복귀 시작 (장비: "); TxEvent.print(i + 1); TxEvent.println(")");
+          motionDone(ACT_RAMEN_EJ, i);
+          motionStart(ACT_RAMEN_EJ, i);   // 복귀 단계 감시 (방금 완료했으므로 FAULT 아님)
+          motorStart(ACT_RAMEN_EJ, RAMEN_EJ_REV_OUT[i]);
+          u.eject = EJECT_RETURNING;
+        }
+        break;
+      case EJECT_RETURNING:
+        if (limitHit(LIMIT_RAMEN_EJ_BTM, i)) {
+          TxEvent.print("완료: 배출 하한 감지. 배출 복귀 모터 정지 (장비: "); TxEvent.print(i + 1); TxEvent.println(")");
+          motionDone(ACT_RAMEN_EJ, i);
+          u.eject = EJECT_IDLE;
+        }
+        break;
+      default: break;
     }
   }
 }
 
 
+/**
+ * @brief 면 장비의 모든 모터(상승/배출) 정지 및 배출 상태 초기화 (FAULT 해제 포함)
+ */
+void stopRamen(uint8_t idx) {
+  motorStop(RAMEN_EJ_FWD_OUT[idx]);
+  motorStop(RAMEN_EJ_REV_OUT[idx]);
+  motorStop(RAMEN_UP_FWD_OUT[idx]);
+  motorStop(RAMEN_UP_REV_OUT[idx]);
+  ramenUnits[idx].eject = EJECT_IDLE;
+  motionStop(ACT_RAMEN_UP, idx);
+  motionStop(ACT_RAMEN_EJ, idx);
+}
+
+/**
+ * @brief 스프 배출 시간 경과 (타이머 휠 콜백)
+ */
+static void powderExpired(uint8_t i) {
+  TxEvent.print("완료: 시간 경과. 스프 배출 중지 (장비: ");
+  TxEvent.print(i + 1);
+  TxEvent.println(")");
+  fioWrite(POWDER_MOTOR_OUT[i], LOW);
+  isPowderDispensing[i] = false;
+}
+
 /**
  * @brief [수정] 스프 배출을 시작 (지정된 장비, 지정된 시간)
+ *        종료는 타이머 휠이 durationMs 후 powderExpired 로 처리
  */
-void startPowderDispense(uint8_t idx, unsigned long durationMs) {
+bool startPowderDispense(uint8_t idx, unsigned long durationMs) {
   if (isPowderDispensing[idx] == false) {
-    Serial.print("명령: 스프 배출 시작 (장비: ");
-    Serial.print(idx + 1);
-    Serial.print(", 시간: ");
-    Serial.print(durationMs);
-    Serial.println("ms)");
+    TxEvent.print("명령: 스프 배출 시작 (장비: ");
+    TxEvent.print(idx + 1);
+    TxEvent.print(", 시간: ");
+    TxEvent.print(durationMs);
+    TxEvent.println("ms)");
     
     isPowderDispensing[idx] = true;
-    powderDuration[idx] = durationMs;
-    powderStartTime[idx] = millis();
-    digitalWrite(POWDER_MOTOR_OUT[idx], HIGH);
+    timerStart(powderTimers[idx], durationMs, powderExpired, idx);
+    fioWrite(POWDER_MOTOR_OUT[idx], HIGH);
+    return true;
   }
+  TxEvent.print("Warning: Powder command ignored. Already dispensing (장비: ");
+  TxEvent.print(idx + 1); TxEvent.println(")");
+  return false;
+}
+
+bool powderDispensing(uint8_t idx) {
+  return isPowderDispensing[idx];
 }
 
 /**
- * @brief 🟢 [복구] "모든" 스프 배출 타이머를 확인 (loop에서 계속 호출)
+ * @brief 스프 배출 강제 정지
  */
-void checkPowderDispense() {
-  for (uint8_t i = 0; i < current.powder; i++) { 
-    if (isPowderDispensing[i]) {
-      if (millis() - powderStartTime[i] >= powderDuration[i]) {
-        Serial.print("완료: 시간 경과. 스프 배출 중지 (장비: ");
-        Serial.print(i + 1);
-        Serial.println(")");
-        digitalWrite(POWDER_MOTOR_OUT[i], LOW);
-        isPowderDispensing[i] = false;
-      }
-    }
-  }
+void stopPowderDispense(uint8_t idx) {
+  fioWrite(POWDER_MOTOR_OUT[idx], LOW);
+  isPowderDispensing[idx] = false;
+  timerCancel(powderTimers[idx]);
 }
 
 /**
  * @brief [수정] 배출구 오픈 시작 (모든 장비)
  */
-void startOutletOpen(int pinIdx) {
-  Serial.print("명령: 배출구 오픈 시작 (장비: ");
-  Serial.print(pinIdx + 1);
-  Serial.println(")");
-  digitalWrite(OUTLET_FWD_OUT[pinIdx], HIGH);
+bool startOutletOpen(int pinIdx) {
+  TxEvent.print("명령: 배출구 오픈 시작 (장비: ");
+  TxEvent.print(pinIdx + 1);
+  TxEvent.println(")");
+  if (!motionStart(ACT_OUTLET, pinIdx)) return false;
+  motorStop(OUTLET_REV_OUT[pinIdx]);
+  motorStart(ACT_OUTLET, OUTLET_FWD_OUT[pinIdx]);
+  return true;
 }
 
 /**
  * @brief [수정] 배출구 닫기 시작 (모든 장비)
  */
-void startOutletClose(int pinIdx) {
-  Serial.print("명령: 배출구 닫기 시작 (장비: ");
-  Serial.print(pinIdx + 1);
-  Serial.println(")");
-  digitalWrite(OUTLET_REV_OUT[pinIdx], HIGH);
+bool startOutletClose(int pinIdx) {
+  TxEvent.print("명령: 배출구 닫기 시작 (장비: ");
+  TxEvent.print(pinIdx + 1);
+  TxEvent.println(")");
+  if (!motionStart(ACT_OUTLET, pinIdx)) return false;
+  motorStop(OUTLET_FWD_OUT[pinIdx]);
+  motorStart(ACT_OUTLET, OUTLET_REV_OUT[pinIdx]);
+  return true;
+}
+
+/**
+ * @brief 배출구 모터 정지 (양방향)
+ */
+void stopOutlet(int pinIdx) {
+  motorStop(OUTLET_FWD_OUT[pinIdx]);
+  motorStop(OUTLET_REV_OUT[pinIdx]);
+  motionStop(ACT_OUTLET, pinIdx);
 }
 
 /**
- * @brief 🟢 [복구] 배출구 오픈/닫힘 멈춤 조건을 "모든 장비"에 대해 확인
- * (loop()에서 계속 호출)
+ * @brief 🟢 [복구] 배출구 오픈/닫힘 완료를 "모든 장비"에 대해 처리
+ * (loop()에서 계속 호출, 모터 차단은 리밋 인터럽트가 함)
  */
 void checkOutlet() {
   for (uint8_t i = 0; i < current.outlet; i++) {
-    if (digitalRead(OUTLET_FWD_OUT[i]) == HIGH) {
-      if (digitalRead(OUTLET_OPEN_IN[i]) == LOW) {
-        Serial.print("완료: 배출구 오픈 완료 (장비: "); Serial.print(i + 1); Serial.println(")");
-        digitalWrite(OUTLET_FWD_OUT[i], LOW);
-      }
+    if (limitHit(LIMIT_OUTLET_OPEN, i)) {
+      TxEvent.print("완료: 배출구 오픈 완료 (장비: "); TxEvent.print(i + 1); TxEvent.println(")");
+      motionDone(ACT_OUTLET, i);
     }
-
-    if (digitalRead(OUTLET_REV_OUT[i]) == HIGH) {
-      if (digitalRead(OUTLET_CLOSE_IN[i]) == LOW) {
-        Serial.print("완료: 배출구 닫힘 완료 (장비: "); Serial.print(i + 1); Serial.println(")");
-        digitalWrite(OUTLET_REV_OUT[i], LOW);
-      }
+    if (limitHit(LIMIT_OUTLET_CLOSE, i)) {
+      TxEvent.print("완료: 배출구 닫힘 완료 (장비: "); TxEvent.print(i + 1); TxEvent.println(")");
+      motionDone(ACT_OUTLET, i);
     }
   }
 }
 
-
-// =======================================================
-// === 3. JSON 명령 핸들러 (API 2.x)
-// =======================================================
-
-bool handleCupCommand(const JsonDocument& doc) {
-  int control = doc["control"] | 0;
-  const char* func = doc["function"] | "";
-  if (control <= 0 || control > current.cup) { Serial.println("invalid cup control num"); return false; }
-  uint8_t idx = control - 1;
-
-  if (strcmp(func, "startdispense") == 0) {
-    startCupDispense(idx); // 🔴 [수정] idx 인자 전달
-    Serial.println("cup startdispense");
-  } else if (strcmp(func, "stopdispense") == 0) {
-    digitalWrite(CUP_MOTOR_OUT[idx], LOW);
-    Serial.println("cup stopdispense");
-  } else { Serial.println("unknown cup function"); }
-  return true;
-}
-
-bool handleRamenCommand(const JsonDocument& doc) {
-  int control = doc["control"] | 0;
-  const char* func = doc["function"] | "";
-  if (control <= 0 || control > current.ramen) { Serial.println("invalid ramen control num"); return false; }
-  uint8_t idx = control - 1;
-  Serial.println("start handle ramen");
-
-  if (strcmp(func, "startdispense") == 0) {
-    startRamenEject(idx); // 🔴 [수정] idx 인자 전달
-    Serial.println("ramen startdispense");
-  } else if (strcmp(func, "readydispense") == 0) {
-    startRamenRise(idx); // 🔴 [수정] idx 인자 전달
-    Serial.println("ramen readydispense");
-  } else if (strcmp(func, "initdispense") == 0) {
-    startRamenInit(idx); // 🔴 [수정] idx 인자 전달
-    Serial.println("ramen initdispense");
-  } else if (strcmp(func, "stopdispense") == 0) {
-    digitalWrite(RAMEN_EJ_FWD_OUT[idx], LOW);
-    digitalWrite(RAMEN_EJ_REV_OUT[idx], LOW);
-    digitalWrite(RAMEN_UP_FWD_OUT[idx], LOW);
-    digitalWrite(RAMEN_UP_REV_OUT[idx], LOW);
-    if (idx == 0) { ramenEjectStatus = EJECT_IDLE; }
-    Serial.println("ramen stopdispense (ALL STOP)");
-  } else { Serial.println("unknown ramen function"); }
-  return true;
+/**
+ * @brief 쿠커 조리 시작: 급수 -> 예열 -> 유지(timer 초) -> 완료 (cooker.cpp)
+ */
+bool startCook(uint8_t idx, int water, int timer) {
+  TxEvent.print("명령: 조리 시작 (장비: "); TxEvent.print(idx + 1);
+  TxEvent.print(", 물: "); TxEvent.print(water);
+  TxEvent.print("ml, 시간: "); TxEvent.print(timer); TxEvent.println("s)");
+  return cookerStart(idx, water, timer);
 }
 
-bool handlePowderCommand(const JsonDocument& doc) {
-  int control = doc["control"] | 0;
-  const char* func = doc["function"] | "";
-  if (control <= 0 || control > current.powder) { Serial.println("invalid powder control num"); return false; }
-  uint8_t idx = control - 1;
-
-  if (strcmp(func, "startdispense") == 0) {
-    
-    int time_val = doc["time"] | 0; 
-    
-    if (time_val <= 0) { Serial.println("Error: 'time' 0 or missing for powder dispense"); return false; }
-
-    unsigned long durationMs = (unsigned long)time_val * 100;
-
-    Serial.print("powder startdispense (장비: ");
-    Serial.print(idx + 1); // 🔴 [수정] idx + 1
-    Serial.print(", 시간: ");
-    Serial.print(durationMs);
-    Serial.println(" ms)");
-
-    startPowderDispense(idx, durationMs);
-  } else if (strcmp(func, "stopdispense") == 0) {
-    digitalWrite(POWDER_MOTOR_OUT[idx], LOW);
-    isPowderDispensing[idx] = false; 
-    Serial.println("powder stopdispense");
-  } else { Serial.println("unknown powder function"); }
-  return true;
+/**
+ * @brief 쿠커 조리 중단
+ */
+void stopCook(uint8_t idx) {
+  cookerStop(idx);
 }
 
-bool handleCookerCommand(const JsonDocument& doc) {
-  int control = doc["control"] | 0;
-  const char* func = doc["function"] | "";
-  if (control <= 0 || control > current.cooker) { Serial.println("invalid cooker control num"); return false; }
-  uint8_t idx = control - 1;
-
-  if (strcmp(func, "startcook") == 0) {
-    int water = doc["water"];
-    int timer = doc["timer"];
-    if (idx < 2) {
-      digitalWrite(COOKER_WTR_SIG[idx], HIGH);
-      digitalWrite(COOKER_IND_SIG[idx], HIGH);
-    }
-    Serial.println("cooker startcook");
-
-  } else if (strcmp(func, "stopcook") == 0) {
-    if (idx < 2) {
-      digitalWrite(COOKER_WTR_SIG[idx], LOW);
-      digitalWrite(COOKER_IND_SIG[idx], LOW);
-    }
-    Serial.println("cooker stopcook");
 
-  } else { Serial.println("unknown cooker function"); }
-  return true;
-}
+// =======================================================
+// === 3. JSON 명령 핸들러 (API 2.x, 명령 목록은 dispatch.cpp)
+// =======================================================
 
-bool handleOutletCommand(const JsonDocument& doc) {
+/**
+ * @brief 장비 명령 공통 처리: 명령 테이블 조회 후 인자 스키마대로 파싱하여 실행
+ */
+static uint8_t handleDeviceCommand(const DeviceSpec* dev, JsonVariantConst doc, bool quiet) {
   int control = doc["control"] | 0;
   const char* func = doc["function"] | "";
-  if (control <= 0 || control > current.outlet) { Serial.println("invalid outlet control num"); return false; }
-  uint8_t idx = control - 1;
-
-  if (strcmp(func, "opendoor") == 0) {
-    startOutletOpen(idx);
-    digitalWrite(OUTLET_REV_OUT[idx], LOW);
-    Serial.println("outlet opendoor");
-
-  } else if (strcmp(func, "closedoor") == 0) {
-    startOutletClose(idx);
-    digitalWrite(OUTLET_FWD_OUT[idx], LOW);
-    Serial.println("outlet closedoor");
+  if (control <= 0 || control > deviceCount(dev->id)) {
+    TxEvent.print("invalid "); TxEvent.print(dev->name); TxEvent.println(" control num");
+    return CMD_ERR_CONTROL;
+  }
 
-  } else if (strcmp(func, "stopoutlet") == 0) {
-    digitalWrite(OUTLET_FWD_OUT[idx], LOW);
-    digitalWrite(OUTLET_REV_OUT[idx], LOW);
-    Serial.println("outlet stopoutlet");
+  const CommandSpec* cmd = findCommand(dev, func);
+  if (cmd == nullptr) {
+    TxEvent.print("unknown "); TxEvent.print(dev->name); TxEvent.println(" function");
+    return CMD_ERR_OPCODE;
+  }
 
-  } else { Serial.println("unknown outlet function"); }
-  return true;
+  CommandArgs args;
+  commandArgsFromJson(cmd, doc, args);
+
+  uint8_t status = executeCommand(cmd, control, args);
+  if (status == CMD_ERR_ARG) {
+    for (uint8_t a = 0; a < ARG_COUNT; a++) {
+      if ((cmd->required & ARG_BIT(a)) && args.v[a] == 0) {
+        TxEvent.print("Error: '"); TxEvent.print(COMMAND_ARG_NAMES[a]);
+        TxEvent.print("' 0 or missing for "); TxEvent.print(dev->name);
+        TxEvent.print(" "); TxEvent.println(cmd->function);
+        break;
+      }
+    }
+    return status;
+  }
+  if (status != CMD_OK) return status;   // 시작 거부: 경고는 start* 가 이미 출력
+  if (!quiet) TxEvent.println(cmd->reply);   // seq 가 있으면 ack 로 대신함
+  return status;
 }
 
 // =======================================================
 // === 4. 메인 파서 (Main Parser)
 // =======================================================
 
-bool handleSettingJson(const JsonDocument& doc) {
+bool handleSettingJson(JsonVariantConst doc) {
   Setting next;
   next.cup = doc["cup"] | 0;
   next.ramen = doc["ramen"] | 0;
@@ -474,29 +497,113 @@ bool handleSettingJson(const JsonDocument& doc) {
   next.cooker = doc["cooker"] | 0;
   next.outlet = doc["outlet"] | 0;
 
+  // "protocol": "json" | "binary" (생략 시 현재 값 유지)
+  const char* proto = doc["protocol"] | "";
+  next.protocol = current.protocol;
+  if (strcmp(proto, "binary") == 0) { next.protocol = PROTO_BINARY; }
+  else if (strcmp(proto, "json") == 0) { next.protocol = PROTO_JSON; }
+  else if (proto[0] != '\0') { TxEvent.println("unknown protocol"); return false; }
+
+  // "telemetry": "full" | "delta" | "subscribe" (생략 시 현재 값 유지)
+  const char* telem = doc["telemetry"] | "";
+  next.telemetry = current.telemetry;
+  if (strcmp(telem, "delta") == 0) { next.telemetry = TELEMETRY_DELTA; }
+  else if (strcmp(telem, "full") == 0) { next.telemetry = TELEMETRY_FULL; }
+  else if (strcmp(telem, "subscribe") == 0) { next.telemetry = TELEMETRY_SUBSCRIBE; }
+  else if (telem[0] != '\0') { TxEvent.println("unknown telemetry mode"); return false; }
+
+  // 장비 수 없이 protocol/telemetry 만 보낸 경우: 통신 방식만 전환
+  if ((proto[0] != '\0' || telem[0] != '\0') &&
+      !next.cup && !next.ramen && !next.powder && !next.cooker && !next.outlet) {
+    current.protocol = next.protocol;
+    current.telemetry = next.telemetry;
+    telemetryReset();
+    replyCurrentSetting(current);
+    return true;
+  }
+
   String reason = "";
-  if (!validateRules(next, reason)) { Serial.println(reason.c_str()); return false; }
+  if (!validateRules(next, reason)) { TxEvent.println(reason.c_str()); return false; }
 
   applySetting(next);
-  Serial.println("pins configured");
+  TxEvent.println("pins configured");
+  return true;
+}
+
+bool handleStatsCommand(JsonVariantConst doc) {
+  const char* func = doc["function"] | "";
+  if (strcmp(func, "reset") == 0) {
+    profReset();
+    TxEvent.resetStats();
+    TxTelemetry.resetStats();
+    rxResetStats();
+    timerResetStats();
+    limitResetStats();
+    TxEvent.println("stats reset");
+  } else if (strcmp(func, "bench_io") == 0) {
+    replyIoBench();
+  } else {
+    replyProfilerStats();
+    replyRxStats();
+    replyTxStats();
+    replyTimerStats();
+    replyLimitStats();
+  }
+  return true;
+}
+
+bool handleQueryJson(JsonVariantConst doc) {
+  (void)doc;
+  replyCurrentSetting(current);
   return true;
 }
 
 void checkSensor() { /* ... */ }
 
+// "seq" 가 있는 명령의 처리 결과: {"device":"ack|nack","seq":..,"error":..,"us":..}
+static void replyAck(JsonVariantConst seq, uint8_t status, uint32_t us) {
+  StaticJsonDocument<128> doc;
+  doc["device"] = status == CMD_OK ? "ack" : "nack";
+  doc["seq"] = seq;
+  if (status != CMD_OK) doc["error"] = COMMAND_STATUS_NAMES[status];
+  doc["us"] = us;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+// 명령 객체 하나 실행 (한 줄 또는 배열의 원소)
+static uint8_t dispatchObject(JsonVariantConst obj) {
+  JsonVariantConst seq = obj["seq"];
+  uint32_t t0 = micros();
+  uint8_t status;
+
+  const char* name = obj["device"] | "";
+  const DeviceSpec* dev = findDevice(name);
+  if (dev == nullptr) {
+    TxEvent.println("unsupported device field");
+    status = CMD_ERR_OPCODE;
+  } else if (dev->json) {   // setting / query / stats ...
+    status = dev->json(obj) ? CMD_OK : CMD_ERR_REJECTED;
+  } else {
+    status = handleDeviceCommand(dev, obj, !seq.isNull());
+  }
+
+  if (!seq.isNull()) replyAck(seq, status, micros() - t0);
+  return status;
+}
+
 bool parseAndDispatch(const char* json) {
-  StaticJsonDocument<512> doc;
+  StaticJsonDocument<1024> doc;   // recipe steps / 명령 배열 (한 줄 RX_FRAME_MAX 이내)
   DeserializationError err = deserializeJson(doc, json);
-  if (err) { Serial.println("json parse fail"); return false; }
-
-  const char* dev = doc["device"] | "";
-
-  if (strcmp(dev, "setting") == 0) { return handleSettingJson(doc); } 
-  else if (strcmp(dev, "query") == 0) { replyCurrentSetting(current); return true; }
-  else if (strcmp(dev, "cup") == 0) { return handleCupCommand(doc); } 
-  else if (strcmp(dev, "ramen") == 0) { return handleRamenCommand(doc); } 
-  else if (strcmp(dev, "powder") == 0) { return handlePowderCommand(doc); } 
-  else if (strcmp(dev, "cooker") == 0) { return handleCookerCommand(doc); } 
-  else if (strcmp(dev, "outlet") == 0) { return handleOutletCommand(doc); } 
-  else { Serial.println("unsupported device field"); return false; }
+  if (err) { TxEvent.println("json parse fail"); return false; }
+
+  if (!doc.is<JsonArrayConst>()) return dispatchObject(doc.as<JsonVariantConst>()) == CMD_OK;
+
+  // 배치: [{...},{...}] 를 순서대로 한 번에 실행. 한 명령이 실패해도 나머지는 계속
+  bool ok = true;
+  for (JsonVariantConst item : doc.as<JsonArrayConst>()) {
+    if (!item.is<JsonObjectConst>()) { TxEvent.println("batch item is not an object"); ok = false; continue; }
+    if (dispatchObject(item) != CMD_OK) ok = false;
+  }
+  return ok;
 }
\ No newline at end of file
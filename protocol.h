@@ -9,9 +9,15 @@
 // === 1. 메인 파서 및 설정 함수
 // =======================================================
 
-// 메인 JSON 파서
+// 메인 JSON 파서: 명령 객체 하나 또는 명령 배열(배치)
+// "seq" 가 있는 명령은 {"device":"ack|nack","seq":..} 로 결과 응답
 bool parseAndDispatch(const char* json);
 
+// 시스템 명령 핸들러 (dispatch.cpp 의 장비 테이블에서 참조)
+bool handleSettingJson(JsonVariantConst doc);
+bool handleQueryJson(JsonVariantConst doc);
+bool handleStatsCommand(JsonVariantConst doc);
+
 // 설정 적용 함수 (Setting 시 호출)
 void applySetting(const Setting& s);
 void replyCurrentSetting(const Setting& s);
@@ -27,22 +33,32 @@ void setupCooker(uint8_t n);
 
 // =======================================================
 // === 2. 비동기 "시작" 함수 (JSON 핸들러가 호출)
+// ===    start* 는 실제로 시작했으면 true. 거부(동작 중, FAULT 래치)는 경고 후 false
 // =======================================================
 
-// --- Cup (1번 장비 전용) ---
-void startCupDispense();
+// --- Cup ---
+bool startCupDispense(uint8_t idx);
+void stopCupDispense(uint8_t idx);
+
+// --- Ramen ---
+bool startRamenRise(uint8_t idx);
+bool startRamenInit(uint8_t idx);
+bool startRamenEject(uint8_t idx);
+void stopRamen(uint8_t idx);
 
-// --- Ramen (1번 장비 전용) ---
-void startRamenRise();
-void startRamenInit();
-void startRamenEject();
+// --- Powder ---
+bool startPowderDispense(uint8_t idx, unsigned long durationMs);
+void stopPowderDispense(uint8_t idx);
+bool powderDispensing(uint8_t idx);
 
-// --- Powder (1번 장비 전용) ---
-void startPowderDispense();
+// --- Cooker ---
+bool startCook(uint8_t idx, int water, int timer);
+void stopCook(uint8_t idx);
 
 // --- Outlet (모든 장비) ---
-void startOutletOpen(int pinIdx);
-void startOutletClose(int pinIdx);
+bool startOutletOpen(int pinIdx);
+bool startOutletClose(int pinIdx);
+void stopOutlet(int pinIdx);
 
 
 // =======================================================
@@ -52,13 +68,12 @@ void startOutletClose(int pinIdx);
 // --- Cup (1번 장비 전용) ---
 void checkCupDispense();
 
-// --- Ramen (1번 장비 전용) ---
+// --- Ramen ---
 void checkRamenRise();
 void checkRamenInit();
 void checkRamenEject();
 
-// --- Powder (1번 장비 전용) ---
-void checkPowderDispense();
+// --- Powder: 종료는 타이머 휠 콜백 (check 함수 없음) ---
 
 // --- Outlet (모든 장비) ---
 void checkOutlet(); // (내부에서 모든 Outlet을 검사)
@@ -0,0 +1,257 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "recipe.h"
+#include "dispatch.h"
+#include "timerwheel.h"
+#include "txbuffer.h"
+
+struct RecipeStep {
+  const CommandSpec* cmd;   // nullptr = wait 단계
+  CommandArgs args;
+  uint16_t order;
+  uint16_t waitMs;
+  uint8_t control;
+  bool last;                // 주문의 마지막 단계
+};
+
+// 원형 큐: 한 주문의 단계는 연속해서 들어감
+static RecipeStep ring[RECIPE_MAX_STEPS];
+static uint8_t head = 0;
+static uint8_t count = 0;
+
+static bool active = false;        // head 단계를 시작했음
+static uint8_t stepNo = 0;         // 실행 중 주문 안에서의 단계 번호 (0 부터)
+static unsigned long stepStartMs = 0;
+static unsigned long orderStartMs = 0;
+static Timer waitTimer;
+static bool waitDone = false;
+
+static const char* const STATUS_NAMES[] = { "running", "done", "failed" };
+
+static RecipeStep& at(uint8_t i) {
+  return ring[(head + i) % RECIPE_MAX_STEPS];
+}
+
+static void popStep() {
+  head = (head + 1) % RECIPE_MAX_STEPS;
+  count--;
+  active = false;
+}
+
+static void reportStep(const RecipeStep& s, uint8_t status, unsigned long elapsed) {
+  StaticJsonDocument<192> doc;
+  doc["device"] = "recipe";
+  doc["event"] = "step";
+  doc["order"] = s.order;
+  doc["step"] = stepNo + 1;
+  doc["function"] = s.cmd ? s.cmd->function : "wait";
+  if (s.cmd) doc["control"] = s.control;
+  doc["status"] = STATUS_NAMES[status];
+  doc["elapsed"] = elapsed;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+static void reportOrder(uint16_t order, const char* status, unsigned long elapsed) {
+  StaticJsonDocument<128> doc;
+  doc["device"] = "recipe";
+  doc["event"] = "order";
+  doc["order"] = order;
+  doc["status"] = status;
+  doc["elapsed"] = elapsed;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+static void onWaitDone(uint8_t) {
+  waitDone = true;
+}
+
+// head 단계 종료. 실패면 같은 주문의 남은 단계를 버림
+static void finishStep(uint8_t status) {
+  unsigned long now = millis();
+  RecipeStep& s = ring[head];
+  reportStep(s, status, now - stepStartMs);
+  uint16_t order = s.order;
+  bool last = s.last;
+  popStep();
+  stepNo++;
+  if (status == STEP_FAILED) {
+    while (!last && count > 0) {
+      last = ring[head].last;
+      popStep();
+    }
+    last = true;
+  }
+  if (last) {
+    reportOrder(order, status == STEP_FAILED ? "failed" : "done", now - orderStartMs);
+    stepNo = 0;
+  }
+}
+
+void recipePoll() {
+  while (count > 0) {
+    RecipeStep& s = ring[head];
+    if (!active) {
+      active = true;
+      stepStartMs = millis();
+      if (stepNo == 0) orderStartMs = stepStartMs;
+      if (s.cmd == nullptr) {
+        waitDone = false;
+        timerStart(waitTimer, s.waitMs, onWaitDone, 0);
+      } else if (executeCommand(s.cmd, s.control, s.args) != CMD_OK) {
+        finishStep(STEP_FAILED);   // 설정 변경, 장비 동작 중 등으로 실행 시점에 거부됨
+        continue;
+      }
+    }
+
+    uint8_t status;
+    if (s.cmd == nullptr) status = waitDone ? STEP_DONE : STEP_RUNNING;
+    else status = s.cmd->progress ? s.cmd->progress(s.control - 1) : (uint8_t)STEP_DONE;
+    if (status == STEP_RUNNING) return;
+    finishStep(status);   // 즉시 끝나는 단계는 같은 loop 에서 다음 단계로
+  }
+}
+
+// order 의 단계를 큐에서 제거 (order < 0 이면 전부). @return 제거한 주문 수
+static uint8_t cancelOrders(long order) {
+  if (count == 0) return 0;
+  bool headRemoved = order < 0 || ring[head].order == (uint16_t)order;
+  if (headRemoved && (active || stepNo > 0)) {
+    reportOrder(ring[head].order, "canceled", millis() - orderStartMs);
+  }
+  uint8_t kept = 0;
+  uint8_t removed = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    RecipeStep s = at(i);
+    if (order < 0 || s.order == (uint16_t)order) {
+      if (s.last) removed++;
+      continue;
+    }
+    at(kept++) = s;   // kept <= i 이므로 앞으로만 당김
+  }
+  count = kept;
+  if (headRemoved) {
+    timerCancel(waitTimer);
+    active = false;
+    stepNo = 0;
+  }
+  return removed;
+}
+
+void recipeReset() {
+  cancelOrders(-1);
+}
+
+// 단계 하나 검사 + 변환. 오류 메시지를 출력하고 false
+static bool parseStep(JsonVariantConst v, uint8_t n, RecipeStep& out) {
+  const char* devName = v["device"] | "";
+  const char* func = v["function"] | "";
+  out.cmd = nullptr;
+  out.control = 0;
+  out.waitMs = 0;
+  memset(&out.args, 0, sizeof(out.args));
+
+  if (strcmp(devName, "recipe") == 0 && strcmp(func, "wait") == 0) {
+    long ms = v["ms"] | 0L;
+    if (ms <= 0 || ms > (long)RECIPE_WAIT_MAX_MS) {
+      TxEvent.print("recipe step "); TxEvent.print(n + 1); TxEvent.println(": invalid wait ms");
+      return false;
+    }
+    out.waitMs = (uint16_t)ms;
+    return true;
+  }
+
+  const DeviceSpec* dev = findDevice(devName);
+  if (dev == nullptr || dev->id == DEV_SYSTEM) {
+    TxEvent.print("recipe step "); TxEvent.print(n + 1); TxEvent.println(": unsupported device");
+    return false;
+  }
+  const CommandSpec* cmd = findCommand(dev, func);
+  if (cmd == nullptr) {
+    TxEvent.print("recipe step "); TxEvent.print(n + 1);
+    TxEvent.print(": unknown "); TxEvent.print(dev->name); TxEvent.println(" function");
+    return false;
+  }
+  int control = v["control"] | 0;
+  if (control <= 0 || control > deviceCount(dev->id)) {
+    TxEvent.print("recipe step "); TxEvent.print(n + 1);
+    TxEvent.print(": invalid "); TxEvent.print(dev->name); TxEvent.println(" control num");
+    return false;
+  }
+  commandArgsFromJson(cmd, v, out.args);
+  for (uint8_t a = 0; a < ARG_COUNT; a++) {
+    if ((cmd->required & ARG_BIT(a)) && out.args.v[a] == 0) {
+      TxEvent.print("recipe step "); TxEvent.print(n + 1);
+      TxEvent.print(": '"); TxEvent.print(COMMAND_ARG_NAMES[a]); TxEvent.println("' 0 or missing");
+      return false;
+    }
+  }
+  out.cmd = cmd;
+  out.control = (uint8_t)control;
+  return true;
+}
+
+static bool runRecipe(JsonVariantConst doc) {
+  long order = doc["order"] | -1L;
+  if (order < 0 || order > 0xFFFF) { TxEvent.println("recipe run needs order (0~65535)"); return false; }
+  JsonArrayConst steps = doc["steps"].as<JsonArrayConst>();
+  uint8_t n = 0;
+  for (JsonVariantConst v : steps) { (void)v; n++; }
+  if (n == 0) { TxEvent.println("recipe run needs steps"); return false; }
+  if (n > RECIPE_MAX_STEPS - count) { TxEvent.println("recipe queue full"); return false; }
+
+  // 빈 칸에 먼저 채우고 전부 통과해야 count 반영 (주문 일부만 들어가지 않도록)
+  uint8_t i = 0;
+  for (JsonVariantConst v : steps) {
+    RecipeStep& s = at(count + i);
+    if (!parseStep(v, i, s)) return false;
+    s.order = (uint16_t)order;
+    s.last = (i == n - 1);
+    i++;
+  }
+  count += n;
+
+  StaticJsonDocument<128> reply;
+  reply["device"] = "recipe";
+  reply["event"] = "queued";
+  reply["order"] = order;
+  reply["steps"] = n;
+  reply["free"] = RECIPE_MAX_STEPS - count;
+  serializeJson(reply, TxEvent);
+  TxEvent.println();
+  return true;
+}
+
+static void replyStatus() {
+  StaticJsonDocument<256> doc;
+  doc["device"] = "recipe";
+  if (count > 0) {
+    doc["order"] = ring[head].order;
+    doc["step"] = stepNo + 1;
+    doc["elapsed"] = active ? millis() - stepStartMs : 0;
+  }
+  uint8_t orders = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (at(i).last) orders++;
+  }
+  doc["orders"] = orders;
+  doc["pending"] = count;
+  doc["free"] = RECIPE_MAX_STEPS - count;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+bool handleRecipeJson(JsonVariantConst doc) {
+  const char* func = doc["function"] | "status";
+  if (strcmp(func, "run") == 0) return runRecipe(doc);
+  if (strcmp(func, "cancel") == 0) {
+    long order = doc["order"] | -1L;
+    if (cancelOrders(order) == 0) { TxEvent.println("no such recipe order"); return false; }
+  } else if (strcmp(func, "status") != 0) {
+    TxEvent.println("unknown recipe function");
+    return false;
+  }
+  replyStatus();
+  return true;
+}
@@ -0,0 +1,33 @@
+#ifndef RECIPE_H
+#define RECIPE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// =======================================================
+// === 주문 레시피 큐 (호스트 왕복 없이 여러 단계를 연속 실행)
+// === - {"device":"recipe","function":"run","order":N,"steps":[...]}
+// ===   단계 = 일반 장비 명령 {"device":"cup","function":"startdispense","control":1}
+// ===          또는 대기 {"device":"recipe","function":"wait","ms":500}
+// ===   전체 단계를 먼저 검사하고, 하나라도 틀리면 주문 전체를 거부
+// === - 단계 완료 = 명령 테이블의 progress (dispatch.h): check* 함수가 끝낸 동작을
+// ===   동작 감시/과전류/쿠커 단계로 판정. 정지 명령 등 progress 가 없으면 즉시 완료
+// === - 주문은 도착 순서대로 이어서 실행. 단계 실패 시 그 주문의 남은 단계만 버리고 다음 주문
+// === - 이벤트: {"device":"recipe","event":"step","order":..,"step":..,"function":..,
+// ===           "control":..,"status":"done|failed","elapsed":ms}
+// ===           {"device":"recipe","event":"order","order":..,"status":"done|failed|canceled","elapsed":ms}
+// === - {"function":"status"} 대기 현황, {"function":"cancel"[,"order":N]} 주문 취소
+// ===   (취소는 이후 단계만 버림. 이미 구동 중인 동작은 해당 stop 명령으로 정지)
+// =======================================================
+
+/** @brief {"device":"recipe",...} 처리 (dispatch.cpp 의 장비 테이블에서 참조) */
+bool handleRecipeJson(JsonVariantConst doc);
+
+/** @brief 현재 단계 완료 판정 + 다음 단계 시작 (loop 에서, 장비 check* 다음) */
+void recipePoll();
+
+/** @brief 모든 주문 취소 (설정 변경 시) */
+void recipeReset();
+
+#endif // RECIPE_H
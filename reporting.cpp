@@ -3,45 +3,109 @@
 #include "reporting.h"
 #include "config.h" 
 #include "state.h"
+#include "txbuffer.h"
+#include "encoder.h"
+#include "adc.h"
+#include "cooker.h"
+#include "fastio.h"
+#include "measure.h"
+
+static State buffers[2];
+static uint8_t front = 0;          // 발행 스냅샷 = buffers[front]
+static bool sampling = false;      // 작업 버퍼(buffers[front ^ 1]) 가 열려 있음
+static uint32_t frameCount = 0;
+
+const State& stateSnapshot() {
+  return buffers[front];
+}
 
-void readAllSensors() {
+void readSensors(uint8_t group) {
+  State& state = buffers[front ^ 1];
   uint8_t i;
 
-  for (i = 0; i < current.cup; i++) {
-    state.cup_amp[i] = analogRead(CUP_CURR_AIN[i]);
-    state.cup_stock[i] = digitalRead(CUP_STOCK_IN[i]);
-    state.cup_dispense[i] = digitalRead(CUP_ROT_IN[i]);
-  }
-
-  for (i = 0; i < current.ramen; i++) { 
-    state.ramen_amp[i] = analogRead(RAMEN_EJ_CURR_AIN[i]);
-    state.ramen_stock[i] = digitalRead(RAMEN_PRESENT_IN[i]);
-    // state.ramen_lift[i] = ... (엔코더 값 계산 로직 필요)
+  if (!sampling) {
+    state = buffers[front];
+    state.pass_us = micros();
+    sampling = true;
   }
-
-  for (i = 0; i < current.powder; i++) {
-    state.powder_amp[i] = analogRead(POWDER_CURR_AIN[i]);
-    state.powder_dispense[i] = (digitalRead(POWDER_MOTOR_OUT[i]) == LOW) ? 1 : 0; 
+  state.sample_us[group] = micros();
+
+  switch (group) {
+    case TG_CUP:
+      for (i = 0; i < current.cup; i++) {
+        state.cup_amp[i] = adcRead(CUP_CURR_AIN[i]);
+        state.cup_stock[i] = fioRead(CUP_STOCK_IN[i]);
+        state.cup_dispense[i] = fioRead(CUP_ROT_IN[i]);
+      }
+      break;
+
+    case TG_RAMEN:
+      for (i = 0; i < current.ramen; i++) { 
+        state.ramen_amp[i] = adcRead(RAMEN_EJ_CURR_AIN[i]);
+        state.ramen_stock[i] = fioRead(RAMEN_PRESENT_IN[i]);
+        state.ramen_lift[i] = encoderRead(i);
+        state.ramen_velocity[i] = encoderVelocity(i);
+        state.ramen_loadcell[i] = measureValue(MEAS_RAMEN_LOAD, i);   // g, 배선 안 됐으면 0
+      }
+      break;
+
+    case TG_POWDER:
+      for (i = 0; i < current.powder; i++) {
+        state.powder_amp[i] = adcRead(POWDER_CURR_AIN[i]);
+        state.powder_dispense[i] = fioOutput(POWDER_MOTOR_OUT[i]) ? 0 : 1; 
+      }
+      break;
+
+    case TG_COOKER:
+      for (i = 0; i < current.cooker; i++) {
+        state.cooker_amp[i] = adcRead(COOKER_CURR_AIN[i]);
+        state.cooker_work[i] = cookerPhase(i);
+        state.cooker_remain[i] = cookerRemainSec(i);
+      }
+      break;
+
+    case TG_OUTLET:
+      for (i = 0; i < current.outlet; i++) {
+        state.outlet_amp[i] = adcRead(OUTLET_CURR_AIN[i]);
+        state.outlet_sonar[i] = measureValue(MEAS_OUTLET_SONAR, i);      // mm
+        state.outlet_loadcell[i] = measureValue(MEAS_OUTLET_LOAD, i);    // g
+        // state.outlet_door[i] = ...
+      }
+      break;
+
+    default:
+      state.door_sensor1 = fioRead(DOOR_SENSOR1_PIN);
+      state.door_sensor2 = fioRead(DOOR_SENSOR2_PIN);
+      break;
   }
+}
 
-  for (i = 0; i < current.cooker; i++) {
-    state.cooker_amp[i] = analogRead(COOKER_CURR_AIN[i]);
-    // state.cooker_work[i] = ...
-  }
+void snapshotCommit() {
+  if (!sampling) return;
+  uint8_t back = front ^ 1;
+  buffers[back].epoch = buffers[front].epoch + 1;
+  front = back;
+  sampling = false;
+}
 
-  for (i = 0; i < current.outlet; i++) {
-    state.outlet_amp[i] = analogRead(OUTLET_CURR_AIN[i]);
-    state.outlet_sonar[i] = analogRead(OUTLET_USONIC_AIN[i]);
-    state.outlet_loadcell[i] = analogRead(OUTLET_LOAD_AIN[i]);
-    // state.outlet_door[i] = ...
-  }
+void readAllSensors() {
+  for (uint8_t g = 0; g < TG_COUNT; g++) readSensors(g);
+  snapshotCommit();
+}
 
-  state.door_sensor1 = digitalRead(DOOR_SENSOR1_PIN);
-  state.door_sensor2 = digitalRead(DOOR_SENSOR2_PIN);
+uint32_t nextTelemetryFrame() {
+  return ++frameCount;
 }
 
+void stampRecord(JsonDocument& doc, uint8_t group) {
+  const State& snap = buffers[front];
+  doc["epoch"] = snap.epoch;
+  doc["us"] = snap.sample_us[group];
+  doc["frame"] = nextTelemetryFrame();
+}
 
 void publishStateJson() {
+  const State& state = stateSnapshot();
   StaticJsonDocument<512> doc;
   uint8_t i;
 
@@ -49,131 +113,114 @@ void publishStateJson() {
     doc.clear();
     doc["device"] = "cup";
     doc["control"] = i + 1; // 1부터 Role Number까지 보고
+    stampRecord(doc, TG_CUP);
     doc["amp"] = state.cup_amp[i];
     doc["stock"] = state.cup_stock[i];
     doc["dispense"] = state.cup_dispense[i];
-    serializeJson(doc, Serial);
-    Serial.println();
+    serializeJson(doc, TxTelemetry);
+    TxTelemetry.println();
   }
 
   for (i = 0; i < current.ramen; i++) { 
     doc.clear();
     doc["device"] = "ramen";
     doc["control"] = i + 1;
+    stampRecord(doc, TG_RAMEN);
     doc["amp"] = state.ramen_amp[i];
     doc["stock"] = state.ramen_stock[i];
     doc["lift"] = state.ramen_lift[i];
+    doc["velocity"] = state.ramen_velocity[i];
     doc["loadcell"] = state.ramen_loadcell[i];
-    serializeJson(doc, Serial);
-    Serial.println();
+    serializeJson(doc, TxTelemetry);
+    TxTelemetry.println();
   }
 
   for (i = 0; i < current.powder; i++) {
     doc.clear();
     doc["device"] = "powder";
     doc["control"] = i + 1;
+    stampRecord(doc, TG_POWDER);
     doc["amp"] = state.powder_amp[i];
     doc["dispense"] = state.powder_dispense[i];
-    serializeJson(doc, Serial);
-    Serial.println();
+    serializeJson(doc, TxTelemetry);
+    TxTelemetry.println();
   }
 
   for (i = 0; i < current.cooker; i++) {
     doc.clear();
     doc["device"] = "cooker";
     doc["control"] = i + 1;
+    stampRecord(doc, TG_COOKER);
     doc["amp"] = state.cooker_amp[i];
     doc["work"] = state.cooker_work[i];
-    serializeJson(doc, Serial);
-    Serial.println();
+    doc["remain"] = state.cooker_remain[i];
+    serializeJson(doc, TxTelemetry);
+    TxTelemetry.println();
   }
 
   for (i = 0; i < current.outlet; i++) {
     doc.clear();
     doc["device"] = "outlet";
     doc["control"] = i + 1;
+    stampRecord(doc, TG_OUTLET);
     doc["amp"] = state.outlet_amp[i];
     doc["door"] = state.outlet_door[i];
     doc["sonar"] = state.outlet_sonar[i];
     doc["loadcell"] = state.outlet_loadcell[i];
-    serializeJson(doc, Serial);
-    Serial.println();
+    serializeJson(doc, TxTelemetry);
+    TxTelemetry.println();
   }
 
   doc.clear();
   doc["device"] = "door";
+  stampRecord(doc, TG_DOOR);
   doc["sensor1"] = state.door_sensor1;
   doc["sensor2"] = state.door_sensor2;
-  serializeJson(doc, Serial);
-  Serial.println();
+  serializeJson(doc, TxTelemetry);
+  TxTelemetry.println();
 }
 
 void checkVolt() {
-  int v = analogRead(A3);
+  int v = adcRead(A3);
   
-  Serial.print("current vol : ");
-  Serial.println(v);
+  TxEvent.print("current vol : ");
+  TxEvent.println(v);
 }
 
-// 엔코더 상태 출력 함수 (100ms 마다 실행)
+// 엔코더 상태 출력 함수 (100ms 마다 실행, 설정된 면 장비 전체)
 void reportEncoderDebug(unsigned long currentMillis) {
-  if (currentMillis - lastEncoderReportTime >= 100) {
-    
-    noInterrupts();
-    long countCopy = encoderCount;
-    int dirCopy = direction;
-    interrupts();
+  static unsigned long lastEncoderReportTime = 0;
+  static int32_t lastCount[ENCODER_UNITS] = {0};
 
+  if (currentMillis - lastEncoderReportTime >= 100) {
     // 시간 차이 계산 (초 단위)
     float dt = (currentMillis - lastEncoderReportTime) / 1000.0;
-    
-    // 카운트 차이 및 속도 계산
-    long dCount = countCopy - lastCount;
-    float revPerSec = (float)dCount / (float)CPR / dt;
-    float rpm = revPerSec * 60.0;
-    
-    // 각도 계산 (도 단위)
-    float angleDeg = (float)countCopy * 360.0 / (float)CPR;
-
-    // 상태 업데이트
     lastEncoderReportTime = currentMillis;
-    lastCount = countCopy;
-
-    // 시리얼 출력
-    Serial.print("[Encoder] Count: ");
-    Serial.print(countCopy);
-    Serial.print(" | Angle: ");
-    Serial.print(angleDeg, 1);
-    Serial.print(" deg | Dir: ");
-    Serial.print((dirCopy >= 0) ? "CW" : "CCW");
-    Serial.print(" | RPM: ");
-    Serial.println(rpm, 1);
-  }
-}
 
-void handleEncoderA() {
-  bool A = digitalRead(ENCODER_A_PIN);
-  bool B = digitalRead(ENCODER_B_PIN);
-
-  if (A == B) {
-    encoderCount++;  // CW
-    direction = +1;
-  } else {
-    encoderCount--;  // CCW
-    direction = -1;
+    for (uint8_t i = 0; i < current.ramen; i++) {
+      int32_t countCopy = encoderRead(i);
+
+      // 카운트 차이 및 속도 계산
+      long dCount = countCopy - lastCount[i];
+      float revPerSec = (float)dCount / (float)ENCODER_CPR / dt;
+      float rpm = revPerSec * 60.0;
+
+      // 각도 계산 (도 단위)
+      float angleDeg = (float)countCopy * 360.0 / (float)ENCODER_CPR;
+      lastCount[i] = countCopy;
+
+      // 시리얼 출력
+      TxEvent.print("[Encoder "); TxEvent.print(i + 1);
+      TxEvent.print("] Count: ");
+      TxEvent.print(countCopy);
+      TxEvent.print(" | Angle: ");
+      TxEvent.print(angleDeg, 1);
+      TxEvent.print(" deg | Dir: ");
+      TxEvent.print((dCount >= 0) ? "CW" : "CCW");
+      TxEvent.print(" | RPM: ");
+      TxEvent.print(rpm, 1);
+      TxEvent.print(" | Err: ");
+      TxEvent.println(encoderErrors(i));
+    }
   }
 }
-
-// B 채널 인터럽트 서비스 루틴
-void handleEncoderB() {
-  bool A = digitalRead(ENCODER_A_PIN);
-  bool B = digitalRead(ENCODER_B_PIN);
-
-  if (A != B) {
-    encoderCount++;  // CW
-    direction = +1;
-  } else {
-    encoderCount--;  // CCW
-    direction = -1;
-  }
-} 
\ No newline at end of file
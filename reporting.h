@@ -3,12 +3,39 @@
 
 #include <Arduino.h>
 
+#include <ArduinoJson.h>
+#include "state.h"
+
+// =======================================================
+// === 센서 스냅샷 (State 이중 버퍼)
+// === - readSensors() 는 작업 버퍼에만 쓰고, snapshotCommit() 이 한 번에 교체
+// ===   → 발행 쪽(stateSnapshot)은 항상 완성된 한 회차의 값만 봄
+// === - 작업 버퍼는 직전 스냅샷에서 시작 (일부 묶음만 읽어도 나머지는 유지)
+// === - 묶음별 샘플 시각(sample_us, micros)과 스냅샷 번호(epoch, 커밋마다 +1)
+// === - 텔레메트리 레코드마다 "epoch","us"(그 묶음의 샘플 시각),"frame"(레코드 번호)
+// ===   frame 은 보낸 레코드마다 +1 → 호스트가 빈 번호로 송신 버퍼 드롭을 알 수 있음
+// =======================================================
+
+/** @brief 한 묶음의 설정된 장비만 작업 버퍼로 읽기 (필요하면 작업 버퍼 시작) */
+void readSensors(uint8_t group);
+
+/** @brief 작업 버퍼를 발행 스냅샷으로 교체 (epoch + 1) */
+void snapshotCommit();
+
+/** @brief 모든 묶음 읽기 + 커밋 */
 void readAllSensors();
+
+/** @brief 마지막으로 커밋된 스냅샷 (발행 쪽은 이것만 읽음) */
+const State& stateSnapshot();
+
+/** @brief 레코드 공통 필드 추가: epoch, us (group 의 샘플 시각), frame */
+void stampRecord(JsonDocument& doc, uint8_t group);
+
+/** @brief 다음 레코드 번호 (바이너리 StatePacket 용, stampRecord 와 같은 카운터) */
+uint32_t nextTelemetryFrame();
 void checkVolt();
 void publishStateJson();
 
-void handleEncoderA();
-void handleEncoderB();
 void reportEncoderDebug(unsigned long currentMillis);
 
 #endif // REPORTING_H
\ No newline at end of file
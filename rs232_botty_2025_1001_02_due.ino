@@ -6,25 +6,35 @@
 #include "state.h"      // Setting/State 구조체, 전역변수 선언
 #include "protocol.h"   // 수신 명령
 #include "reporting.h"  // 상태 보고
+#include "profiler.h"   // 루프 단계별 소요 시간 계측
+#include "txbuffer.h"   // 논블로킹 시리얼 송신
+#include "rxframe.h"    // 고정 크기 명령 수신
+#include "binproto.h"   // 바이너리 프레임 프로토콜
+#include "dispatch.h"   // 명령 테이블
+#include "telemetry.h"  // 변경 기반 텔레메트리
+#include "encoder.h"    // 면 리프트 엔코더 (속도/정체)
+#include "adc.h"        // DMA ADC 스캔 + 필터
+#include "tick.h"       // 1kHz 고정 주기 tick
+#include "protect.h"    // 과전류 보호
+#include "supervisor.h" // 동작 시간 감시 + 워치독
+#include "timerwheel.h" // 해시 타이머 휠
+#include "recipe.h"     // 주문 레시피 큐
+#include "limit.h"      // 리밋 스위치 인터럽트
+#include "fastio.h"     // PIO 레지스터 I/O
+#include "measure.h"    // 로드셀/초음파 측정
+#include "nvconfig.h"   // 플래시 설정 저장소
 
 // ===== 전역 변수 정의 =====
 Setting current;
-State state;
-String rx;
-unsigned long lastPublishMs = 0;
-
-// ===== 엔코더 관련 설정 =====
-const int ENCODER_A_PIN = 2;
-const int ENCODER_B_PIN = 3;
-
-const int PPR = 100;           
-const int CPR = PPR * 4;      
-
-volatile long encoderCount = 0;
-volatile int  direction = 0;
-
-unsigned long lastEncoderReportTime = 0;
-long lastCount = 0;
+Tuning tuning;
+static Timer publishTimer;        // tuning.publishMs 주기
+static bool publishDue = false;
+
+// 만료 시각 기준으로 재등록하므로 loop 지연이 주기에 누적되지 않음
+static void onPublishTimer(uint8_t) {
+  publishDue = true;
+  timerStartAt(publishTimer, publishTimer.due + tuning.publishMs, onPublishTimer, 0);
+}
 
 void setup() {
   Serial.begin(115200);
@@ -34,35 +44,52 @@ void setup() {
   analogReadResolution(10);
 #endif
 
+  fioBegin();   // 핀 -> PIO 포트/비트 표 (이후 디지털 I/O 는 fio*)
+  dispatchBegin();
+  adcBegin();   // 이후 아날로그 값은 adcRead() 로만 읽음
+  measureBegin();   // 로드셀/초음파 교정 기본값 (저장값은 configBegin 이 덮어씀)
+  fastTickBegin();
+  watchdogBegin();   // 직전 리셋 원인 보고 (WDT 자체는 watchdogSetup() 에서 시작)
+
   pinMode(DOOR_SENSOR1_PIN, INPUT);
   pinMode(DOOR_SENSOR2_PIN, INPUT);
 
-  Serial.println(F("{\"boot\":\"ready\",\"hint\":\"send {\\\"device\\\":\\\"setting\\\",...} or {\\\"device\\\":\\\"query\\\"}\"}"));
-  lastPublishMs = millis();
-
-  pinMode(ENCODER_A_PIN, INPUT_PULLUP);
-  pinMode(ENCODER_B_PIN, INPUT_PULLUP);
-
-  // A, B 둘 다 인터럽트 사용 (정밀도 높게)
-  attachInterrupt(digitalPinToInterrupt(ENCODER_A_PIN), handleEncoderA, CHANGE);
-  attachInterrupt(digitalPinToInterrupt(ENCODER_B_PIN), handleEncoderB, CHANGE);
+  TxEvent.println(F("{\"boot\":\"ready\",\"hint\":\"send {\\\"device\\\":\\\"setting\\\",...} or {\\\"device\\\":\\\"query\\\"}\"}"));
+  configBegin();   // 저장된 장비 구성/파라미터 복원 (있으면 setting 없이 바로 동작)
+  timerStart(publishTimer, tuning.publishMs, onPublishTimer, 0);
+  // 엔코더 인터럽트는 setting 의 ramen 수에 맞춰 setupRamen() 에서 연결 (encoder.cpp)
 }
 
 void loop() {
+  PROF_BEGIN();
+
+  fioSnapshot();    // 이번 loop 의 디지털 입력 (PIOA~D 한 번씩)
+  adcPoll();
+  fastTickPoll();   // 비 SAM: 엔코더/과전류 tick (SAM 은 TC3 인터럽트)
+  protectPoll();
+  limitPoll();      // 스위치가 끊은 출력 -> check* 에서 완료 처리
+  PROF_STAGE(PROF_ADC);
+
+  timerPoll(millis());  // 스프/쿠커 종료, 발행 주기, 동작 감시 마감
+  PROF_STAGE(PROF_TIMER);
+
   if (current.cup > 0) {
     checkCupDispense();  
+    PROF_STAGE(PROF_CUP);
   }
   if (current.ramen > 0) {
+    encoderPoll();      // 속도 추정 tick(비 SAM) + 정체 정지 보고
     checkRamenRise();   
     checkRamenInit();   
     checkRamenEject();  
-  }
-  if (current.powder > 0) {
-    checkPowderDispense(); 
+    PROF_STAGE(PROF_RAMEN);
   }
   if (current.outlet > 0) {
     checkOutlet();
+    measurePoll();    // 그릇 감지 / 목표 무게 이벤트
+    PROF_STAGE(PROF_OUTLET);
   }
+  recipePoll();   // 위 check* 결과로 단계 완료 판정 후 다음 단계 시작
 
   // Serial.print("면 배출 상한 센서 : ");
   // Serial.println(digitalRead(8));
@@ -76,36 +103,50 @@ void loop() {
   // ================================================
   // 2. [실시간] JSON 명령 수신
   // ================================================
-  while (Serial.available()) {
-    char c = Serial.read();
-    if (c == '\n' || c == '\r') {
-      if (rx.length() > 0) {
-        parseAndDispatch(rx.c_str());
-        rx = "";
-      }
-    } else {
-      rx += c;
-    }
-  }
+  rxPoll();
+  PROF_STAGE(PROF_RX);
 
   unsigned long now = millis();
-  if (now - lastPublishMs >= PUBLISH_INTERVAL_MS) {
-    lastPublishMs = now;
-
-    if (current.cup > 0 || current.ramen > 0 || current.powder > 0 || current.cooker > 0 || current.outlet > 0) {
+  bool configured = current.cup > 0 || current.ramen > 0 || current.powder > 0 || current.cooker > 0 || current.outlet > 0;
+  if (configured && current.telemetry == TELEMETRY_DELTA) {
+    // 변경분/에지/키프레임 판단은 telemetry.cpp 에서 (자체 샘플링 주기)
+    PROF_SKIP();
+    if (telemetryPoll(now)) PROF_STAGE(PROF_PUBLISH);
+  } else if (configured && current.telemetry == TELEMETRY_SUBSCRIBE) {
+    // 구독별 주기로 해당 장비만 읽고 보냄 (telemetry.cpp)
+    PROF_SKIP();
+    if (subscriptionPoll(now)) PROF_STAGE(PROF_PUBLISH);
+  } else if (publishDue) {
+    publishDue = false;
+    PROF_SKIP();
+
+    if (configured) {
       readAllSensors();     // Reporting.cpp 에 정의됨
-      publishStateJson();
+      if (current.protocol == PROTO_BINARY) publishStateBinary();
+      else publishStateJson();
     } else {
       // setting 안된 경우에 보냄
-      state.door_sensor1 = digitalRead(DOOR_SENSOR1_PIN);
-      state.door_sensor2 = digitalRead(DOOR_SENSOR2_PIN);
+      readSensors(TG_DOOR);
+      snapshotCommit();
+      const State& snap = stateSnapshot();
 
-      StaticJsonDocument<128> doorDoc;
+      StaticJsonDocument<160> doorDoc;
       doorDoc["device"] = "door";
-      doorDoc["sensor1"] = state.door_sensor1;
-      doorDoc["sensor2"] = state.door_sensor2;
-      serializeJson(doorDoc, Serial);
-      Serial.println();
+      stampRecord(doorDoc, TG_DOOR);
+      doorDoc["sensor1"] = snap.door_sensor1;
+      doorDoc["sensor2"] = snap.door_sensor2;
+      serializeJson(doorDoc, TxTelemetry);
+      TxTelemetry.println();
     }
+    PROF_STAGE(PROF_PUBLISH);
   }
+
+  // ================================================
+  // 3. 송신 버퍼 -> UART (빈 공간만큼만, 논블로킹)
+  // ================================================
+  txPump();
+  PROF_STAGE(PROF_TX);
+
+  watchdogKick(millis());
+  PROF_END();
 }
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "rxframe.h"
+#include "config.h"
+#include "protocol.h"
+#include "binproto.h"
+#include "dispatch.h"
+#include "state.h"
+#include "txbuffer.h"
+
+static char rxFrame[RX_FRAME_MAX + 1];   // +1: 문자열 종료 '\0'
+static uint16_t rxLen = 0;
+static bool rxOverflow = false;           // 현재 줄이 넘침 -> 줄 끝까지 폐기
+static bool rxBinary = false;             // 바이너리 프레임 수신 중
+static unsigned long rxBinaryLastMs = 0;  // 마지막으로 프레임 바이트를 받은 시각
+
+static uint32_t rxFrames = 0;
+static uint32_t rxOverflows = 0;
+static uint32_t rxBinaryFrames = 0;
+static uint32_t rxBinaryErrors = 0;
+
+static void rxEndOfLine() {
+  uint16_t len = rxLen;
+  bool overflow = rxOverflow;
+  rxLen = 0;
+  rxOverflow = false;
+
+  if (overflow) {
+    rxOverflows++;
+    TxEvent.print("frame too long (max ");
+    TxEvent.print(RX_FRAME_MAX);
+    TxEvent.println(")");
+  } else if (len > 0) {
+    rxFrame[len] = '\0';
+    rxFrames++;
+    parseAndDispatch(rxFrame);
+  }
+}
+
+// 줄바꿈이 없는 구간을 현재 프레임 뒤에 복사
+static void rxAppend(const char* data, uint16_t n) {
+  if (rxOverflow) return;
+  if ((uint32_t)rxLen + n > RX_FRAME_MAX) {
+    rxOverflow = true;
+    return;
+  }
+  memcpy(&rxFrame[rxLen], data, n);
+  rxLen += n;
+}
+
+static void rxBinaryReset() {
+  rxBinary = false;
+  rxLen = 0;
+}
+
+// 바이너리 프레임 바이트를 복사하고, 완성되면 CRC 검사 후 실행. 소비한 위치 반환
+static const char* rxBinaryFeed(const char* p, const char* end) {
+  uint16_t need = (rxLen >= 2) ? (uint16_t)(BIN_OVERHEAD + (uint8_t)rxFrame[1]) : 2;
+  uint16_t n = (uint16_t)(end - p);
+  if (n > need - rxLen) n = need - rxLen;
+  memcpy(&rxFrame[rxLen], p, n);
+  rxLen += n;
+  p += n;
+
+  if (rxLen == 2 && (uint8_t)rxFrame[1] > BIN_MAX_PAYLOAD) {
+    rxBinaryErrors++;
+    binReplyStatus(0, CMD_ERR_LENGTH);
+    rxBinaryReset();
+    return p;
+  }
+  if (rxLen < 2 || rxLen < BIN_OVERHEAD + (uint8_t)rxFrame[1]) return p;
+
+  const uint8_t* f = (const uint8_t*)rxFrame;
+  uint8_t len = f[1];
+  uint16_t crc = (uint16_t)(f[3 + len] | (f[4 + len] << 8));
+  if (binCrc16(&f[1], (uint16_t)(len + 2)) != crc) {
+    rxBinaryErrors++;
+    binReplyStatus(f[2], CMD_ERR_CRC);
+  } else {
+    rxBinaryFrames++;
+    binDispatch(f[2], &f[3], len);
+  }
+  rxBinaryReset();
+  return p;
+}
+
+/**
+ * @brief 수신된 바이트를 한 번에 읽어 줄 단위로 분리 (loop() 에서 호출)
+ */
+void rxPoll() {
+  // 바이트 간격이 벌어진(중간에 끊긴) 바이너리 프레임은 버림 (다음 SYNC 부터 재동기)
+  unsigned long now = millis();
+  if (rxBinary && now - rxBinaryLastMs > RX_BINARY_TIMEOUT_MS) {
+    rxBinaryErrors++;
+    rxBinaryReset();
+  }
+
+  int avail = Serial.available();
+  if (avail <= 0) return;
+  if (avail > (int)RX_CHUNK) avail = RX_CHUNK;
+
+  char chunk[RX_CHUNK];
+  uint16_t n = (uint16_t)Serial.readBytes(chunk, avail);
+
+  const char* p = chunk;
+  const char* end = chunk + n;
+  while (p < end) {
+    if (rxBinary) {
+      rxBinaryLastMs = now;
+      p = rxBinaryFeed(p, end);
+      continue;
+    }
+    if (rxLen == 0 && !rxOverflow && (uint8_t)*p == BIN_SYNC && current.protocol == PROTO_BINARY) {
+      rxBinary = true;
+      rxBinaryLastMs = now;
+      continue;
+    }
+    const char* eol = p;
+    while (eol < end && *eol != '\n' && *eol != '\r') eol++;
+    rxAppend(p, (uint16_t)(eol - p));
+    if (eol == end) break;
+    rxEndOfLine();
+    p = eol + 1;
+  }
+}
+
+void replyRxStats() {
+  StaticJsonDocument<128> doc;
+  doc["device"] = "stats";
+  doc["stage"] = "rx";
+  doc["frames"] = rxFrames;
+  doc["overflow"] = rxOverflows;
+  doc["binary"] = rxBinaryFrames;
+  doc["binary_error"] = rxBinaryErrors;
+  doc["partial"] = rxLen;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+void rxResetStats() {
+  rxFrames = 0;
+  rxOverflows = 0;
+  rxBinaryFrames = 0;
+  rxBinaryErrors = 0;
+}
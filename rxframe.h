@@ -0,0 +1,18 @@
+#ifndef RXFRAME_H
+#define RXFRAME_H
+
+#include <Arduino.h>
+
+// =======================================================
+// === 고정 크기 수신 프레임 조립기 (힙 할당 없음)
+// === - '\n' 또는 '\r' 로 끝나는 한 줄 = 한 프레임
+// === - RX_FRAME_MAX 를 넘는 줄은 끝까지 버리고 "frame too long" 응답
+// === - 루프 1회에 최대 RX_CHUNK 바이트만 읽어 수신 처리 시간을 제한
+// === - 바이너리 모드에서는 줄 시작이 BIN_SYNC 이면 길이 기반 프레임으로 수신
+// =======================================================
+
+void rxPoll();           // loop() 에서 호출: 완성된 프레임마다 parseAndDispatch()
+void replyRxStats();
+void rxResetStats();
+
+#endif // RXFRAME_H
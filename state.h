@@ -3,6 +3,20 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "actuator.h"
+
+// 통신 프로토콜 (setting 의 "protocol" 필드로 협상)
+enum LinkProtocol : uint8_t {
+  PROTO_JSON   = 0,  // 줄 단위 JSON (기본, 디버깅용)
+  PROTO_BINARY = 1   // 길이+CRC16 바이너리 프레임 (binproto.h)
+};
+
+// 텔레메트리 방식 (setting 의 "telemetry" 필드, telemetry.h)
+enum TelemetryMode : uint8_t {
+  TELEMETRY_FULL  = 0,  // tuning.publishMs 마다 전체 상태 (기본)
+  TELEMETRY_DELTA = 1,  // 변경분 + 에지 이벤트 + 주기 키프레임
+  TELEMETRY_SUBSCRIBE = 2   // 호스트가 고른 장비/필드만 구독별 주기로 ({"device":"subscribe"})
+};
 
 struct Setting {
   uint8_t cup     = 0;
@@ -10,6 +24,29 @@ struct Setting {
   uint8_t powder  = 0;
   uint8_t cooker  = 0;
   uint8_t outlet  = 0;
+  uint8_t protocol = PROTO_JSON;
+  uint8_t telemetry = TELEMETRY_FULL;
+};
+
+// 실행 중 바꿀 수 있는 동작 파라미터 (기본값 config.h, {"device":"config"} 로 변경/저장)
+struct Tuning {
+  uint16_t publishMs = PUBLISH_INTERVAL_MS;   // 전체 상태 발행 / delta 주기
+  int32_t riseTravel[MAX_RAMEN] = {           // 면 1회 상승 최대 이동 (count)
+    RAMEN_RISE_TRAVEL_MAX[0], RAMEN_RISE_TRAVEL_MAX[1], RAMEN_RISE_TRAVEL_MAX[2], RAMEN_RISE_TRAVEL_MAX[3]
+  };
+  uint16_t motionExpectedMs[ACT_COUNT] = {    // 동작 감시 (supervisor.h), 0 = 감시 안 함
+    MOTION_CUP_EXPECTED_MS, MOTION_RAMEN_UP_EXPECTED_MS, MOTION_RAMEN_EJ_EXPECTED_MS,
+    0, MOTION_OUTLET_EXPECTED_MS, 0
+  };
+  uint16_t motionMaxMs[ACT_COUNT] = {
+    MOTION_CUP_MAX_MS, MOTION_RAMEN_UP_MAX_MS, MOTION_RAMEN_EJ_MAX_MS,
+    0, MOTION_OUTLET_MAX_MS, 0
+  };
+};
+
+// 센서 묶음 (장비 종류 + door). 텔레메트리 필드 표, 구독, 샘플 시각이 같은 번호를 쓴다
+enum TelemetryGroup : uint8_t {
+  TG_CUP = 0, TG_RAMEN, TG_POWDER, TG_COOKER, TG_OUTLET, TG_DOOR, TG_COUNT
 };
 
 struct State {
@@ -21,13 +58,15 @@ struct State {
   int ramen_amp[MAX_RAMEN] = {0};
   int ramen_stock[MAX_RAMEN] = {0};
   int ramen_lift[MAX_RAMEN] = {0};
+  int ramen_velocity[MAX_RAMEN] = {0};   // count/s
   int ramen_loadcell[MAX_RAMEN] = {0};
   // Powder
   int powder_amp[MAX_POWDER] = {0};
   int powder_dispense[MAX_POWDER] = {0};
   // Cooker
   int cooker_amp[MAX_COOKER] = {0};
-  int cooker_work[MAX_COOKER] = {0};
+  int cooker_work[MAX_COOKER] = {0};     // CookPhase (cooker.h)
+  int cooker_remain[MAX_COOKER] = {0};   // 완료까지 남은 초
   // Outlet
   int outlet_amp[MAX_OUTLET] = {0};
   int outlet_door[MAX_OUTLET] = {0};
@@ -36,20 +75,13 @@ struct State {
   // Door
   int door_sensor1 = 0;
   int door_sensor2 = 0;
+  // 샘플링 정보 (reporting.h)
+  uint32_t epoch = 0;                  // 커밋된 스냅샷 번호
+  uint32_t pass_us = 0;                // 이 회차 읽기 시작 시각 (micros)
+  uint32_t sample_us[TG_COUNT] = {0};  // 묶음별 마지막 샘플 시각 (micros)
 };
 
 extern Setting current;
-extern State state;
-
-extern const int PPR;
-extern const int CPR; 
-
-extern volatile long encoderCount;
-extern volatile int direction;
-extern unsigned long lastEncoderReportTime; // 52줄 수정됨
-extern long lastCount;
-
-extern const int ENCODER_A_PIN;
-extern const int ENCODER_B_PIN;
+extern Tuning tuning;
 
 #endif // STATE_H
\ No newline at end of file
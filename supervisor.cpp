@@ -0,0 +1,128 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "supervisor.h"
+#include "tick.h"
+#include "txbuffer.h"
+#include "timerwheel.h"
+#include "state.h"
+#include "evlog.h"
+
+// =======================================================
+// === 동작 감시
+// =======================================================
+
+struct MotionSlot {
+  Timer deadline;   // startMs + MAX_MS 에 motionExpired
+  unsigned long startMs;
+  uint8_t state;    // MotionState
+};
+
+static MotionSlot slots[ACT_COUNT][ACTUATOR_MAX_UNITS];
+
+static void motionExpired(uint8_t arg);
+
+static void reportMotion(const char* event, uint8_t act, uint8_t unit, unsigned long elapsed) {
+  StaticJsonDocument<160> doc;
+  doc["device"] = "motion";
+  doc["event"] = event;
+  doc["target"] = ACTUATOR_NAMES[act];
+  doc["control"] = unit + 1;
+  doc["elapsed"] = elapsed;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+bool motionStart(uint8_t act, uint8_t unit) {
+  MotionSlot& s = slots[act][unit];
+  if (s.state == MOTION_FAULT) {
+    TxEvent.print("Warning: "); TxEvent.print(ACTUATOR_NAMES[act]);
+    TxEvent.print(" "); TxEvent.print(unit + 1);
+    TxEvent.println(" motion fault latched. send stop to clear.");
+    return false;
+  }
+  if (tuning.motionMaxMs[act] == 0) return true;   // 감시 대상 아님 (powder/cooker 는 자체 타이머)
+  s.startMs = millis();
+  s.state = MOTION_RUNNING;
+  timerStartAt(s.deadline, s.startMs + tuning.motionMaxMs[act], motionExpired, act * ACTUATOR_MAX_UNITS + unit);
+  return true;
+}
+
+void motionDone(uint8_t act, uint8_t unit) {
+  MotionSlot& s = slots[act][unit];
+  if (s.state != MOTION_RUNNING) return;
+  unsigned long elapsed = millis() - s.startMs;
+  s.state = MOTION_IDLE;
+  timerCancel(s.deadline);
+  if (tuning.motionExpectedMs[act] && elapsed > tuning.motionExpectedMs[act]) reportMotion("slow", act, unit, elapsed);
+}
+
+void motionStop(uint8_t act, uint8_t unit) {
+  MotionSlot& s = slots[act][unit];
+  s.state = MOTION_IDLE;
+  timerCancel(s.deadline);
+}
+
+void motionAbort(uint8_t act, uint8_t unit) {
+  MotionSlot& s = slots[act][unit];
+  if (s.state != MOTION_RUNNING) return;
+  s.state = MOTION_FAULT;
+  timerCancel(s.deadline);
+}
+
+MotionState motionState(uint8_t act, uint8_t unit) {
+  return (MotionState)slots[act][unit].state;
+}
+
+// 최대 시간 만료 (타이머 휠 콜백, arg = act * ACTUATOR_MAX_UNITS + unit)
+static void motionExpired(uint8_t arg) {
+  uint8_t a = arg / ACTUATOR_MAX_UNITS;
+  uint8_t u = arg % ACTUATOR_MAX_UNITS;
+  MotionSlot& s = slots[a][u];
+  if (s.state != MOTION_RUNNING) return;
+  if (actuatorOn(a, u)) {
+    actuatorCut(a, u);
+    s.state = MOTION_FAULT;
+    unsigned long elapsed = millis() - s.startMs;
+    evlogPut(EV_TIMEOUT, EV_TARGET(a, u), (uint16_t)elapsed);
+    reportMotion("timeout", a, u, elapsed);
+  } else {
+    // 이미 다른 보호(과전류/정체)가 출력을 끊었음: 그쪽에서 보고했으므로 조용히 종료
+    s.state = MOTION_IDLE;
+  }
+}
+
+// =======================================================
+// === 워치독
+// === WDT_MR 은 리셋 후 한 번만 쓸 수 있으므로 코어가 init() 에서 부르는
+// === watchdogSetup() 을 재정의해 켠다 (기본 구현은 WDT 를 꺼버림).
+// =======================================================
+
+#ifdef ARDUINO_ARCH_SAM
+void watchdogSetup() {
+  watchdogEnable(WATCHDOG_TIMEOUT_MS);
+}
+#endif
+
+void watchdogBegin() {
+  uint32_t cause = 0;
+#ifdef ARDUINO_ARCH_SAM
+  cause = (RSTC->RSTC_SR & RSTC_SR_RSTTYP_Msk) >> RSTC_SR_RSTTYP_Pos;
+  if (cause == 2) TxEvent.println("Warning: previous reset by watchdog");
+#endif
+  evlogPut(EV_BOOT, (uint8_t)cause, 0);
+}
+
+void watchdogKick(unsigned long now) {
+  static unsigned long lastCheckMs = 0;
+  static uint32_t lastTicks = 0;
+  if (now - lastCheckMs < WATCHDOG_CHECK_MS) return;
+  lastCheckMs = now;
+
+  // fastTick 인터럽트가 멈췄으면 (엔코더/과전류 감시 불능) 리셋되도록 kick 하지 않음
+  uint32_t t = fastTickCount();
+  if (t == lastTicks) return;
+  lastTicks = t;
+#ifdef ARDUINO_ARCH_SAM
+  watchdogReset();
+#endif
+}
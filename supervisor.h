@@ -0,0 +1,56 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "actuator.h"
+
+// =======================================================
+// === 동작 감시 (모든 start*/check* 쌍이 공유) + 하드웨어 워치독
+// ===
+// === 동작 감시
+// === - start* 에서 motionStart(), check* 의 정상 완료에서 motionDone(),
+// ===   stop* 에서 motionStop() 을 부른다.
+// === - 최대 시간(maxMs)을 넘기면 출력 차단 + MOTION_FAULT 래치 + 이벤트.
+// ===   FAULT 동안 motionStart() 는 false (해당 stop 명령으로 해제)
+// === - 정상 완료가 예상 시간(expectedMs)보다 늦으면 "slow" 이벤트 (정비 지표)
+// === - 마감 시각은 슬롯별 타이머 휠 타이머 (timerwheel.h), 만료 시에만 비용 발생
+// === - 이벤트: {"device":"motion","event":"timeout|slow","target":..,"control":..,"elapsed":..}
+// ===
+// === 워치독 (SAM3X WDT, WATCHDOG_TIMEOUT_MS)
+// === - loop 가 돌고 있고 fastTick 인터럽트도 살아 있을 때만 watchdogReset()
+// =======================================================
+
+enum MotionState : uint8_t {
+  MOTION_IDLE = 0,
+  MOTION_RUNNING,
+  MOTION_FAULT
+};
+
+/**
+ * @brief 동작 시작 등록 (시간은 tuning.motionExpectedMs/motionMaxMs, 기본값 config.h)
+ * @return FAULT 상태면 false (호출자는 출력을 켜지 말 것)
+ */
+bool motionStart(uint8_t act, uint8_t unit);
+
+/** @brief 정상 완료 (리밋 스위치 등) */
+void motionDone(uint8_t act, uint8_t unit);
+
+/** @brief 강제 정지 명령: 감시 해제 + FAULT 해제 */
+void motionStop(uint8_t act, uint8_t unit);
+
+/**
+ * @brief 다른 보호 기능(과전류, 리프트 정체)이 동작을 끊었음: RUNNING 이면 FAULT 로
+ *        (보고는 그쪽에서 했으므로 이벤트 없음, loop 에서만 호출)
+ */
+void motionAbort(uint8_t act, uint8_t unit);
+
+MotionState motionState(uint8_t act, uint8_t unit);
+
+/** @brief 워치독 시작 상태 보고 (setup 에서, 직전 리셋이 워치독이면 경고) */
+void watchdogBegin();
+
+/** @brief loop 정상 여부를 확인하고 워치독 리셋 (loop 끝에서 매번) */
+void watchdogKick(unsigned long now);
+
+#endif // SUPERVISOR_H
@@ -0,0 +1,378 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include "telemetry.h"
+#include "state.h"
+#include "reporting.h"
+#include "binproto.h"
+#include "txbuffer.h"
+
+// =======================================================
+// === 필드 테이블
+// === State 의 int 배열 하나 = 필드 하나. deadband 0 은 디지털(에지) 필드.
+// =======================================================
+
+struct TelemetryField {
+  uint8_t group;
+  const char* name;
+  uint16_t offset;     // State 안의 배열 시작 위치 (offsetof)
+  uint16_t deadband;   // 0: 디지털 (값이 바뀌면 즉시 에지 이벤트)
+};
+
+#define TFIELD(g, key, member, db) { g, key, (uint16_t)offsetof(State, member), db }
+
+static const TelemetryField FIELDS[] = {
+  TFIELD(TG_CUP,    "amp",      cup_amp,         TELEMETRY_AMP_DEADBAND),
+  TFIELD(TG_CUP,    "stock",    cup_stock,       0),
+  TFIELD(TG_CUP,    "dispense", cup_dispense,    0),
+  TFIELD(TG_RAMEN,  "amp",      ramen_amp,       TELEMETRY_AMP_DEADBAND),
+  TFIELD(TG_RAMEN,  "stock",    ramen_stock,     0),
+  TFIELD(TG_RAMEN,  "lift",     ramen_lift,      TELEMETRY_LIFT_DEADBAND),
+  TFIELD(TG_RAMEN,  "velocity", ramen_velocity,  TELEMETRY_VELOCITY_DEADBAND),
+  TFIELD(TG_RAMEN,  "loadcell", ramen_loadcell,  TELEMETRY_LOADCELL_DEADBAND),
+  TFIELD(TG_POWDER, "amp",      powder_amp,      TELEMETRY_AMP_DEADBAND),
+  TFIELD(TG_POWDER, "dispense", powder_dispense, 0),
+  TFIELD(TG_COOKER, "amp",      cooker_amp,      TELEMETRY_AMP_DEADBAND),
+  TFIELD(TG_COOKER, "work",     cooker_work,     0),
+  TFIELD(TG_COOKER, "remain",   cooker_remain,   0),
+  TFIELD(TG_OUTLET, "amp",      outlet_amp,      TELEMETRY_AMP_DEADBAND),
+  TFIELD(TG_OUTLET, "door",     outlet_door,     0),
+  TFIELD(TG_OUTLET, "sonar",    outlet_sonar,    TELEMETRY_SONAR_DEADBAND),
+  TFIELD(TG_OUTLET, "loadcell", outlet_loadcell, TELEMETRY_LOADCELL_DEADBAND),
+  TFIELD(TG_DOOR,   "sensor1",  door_sensor1,    0),
+  TFIELD(TG_DOOR,   "sensor2",  door_sensor2,    0),
+};
+static const uint8_t FIELD_COUNT = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+static const char* const GROUP_NAMES[TG_COUNT] = {
+  "cup", "ramen", "powder", "cooker", "outlet", "door"
+};
+
+static uint8_t groupCount(uint8_t g) {
+  switch (g) {
+    case TG_CUP:    return current.cup;
+    case TG_RAMEN:  return current.ramen;
+    case TG_POWDER: return current.powder;
+    case TG_COOKER: return current.cooker;
+    case TG_OUTLET: return current.outlet;
+    default:        return 1;   // door 는 항상 1개
+  }
+}
+
+// 구독 control 상한 (설정과 무관한 장비별 최대치)
+static uint8_t groupMax(uint8_t g) {
+  switch (g) {
+    case TG_CUP:    return MAX_CUP;
+    case TG_RAMEN:  return MAX_RAMEN;
+    case TG_POWDER: return MAX_POWDER;
+    case TG_COOKER: return MAX_COOKER;
+    case TG_OUTLET: return MAX_OUTLET;
+    default:        return 1;
+  }
+}
+
+static inline int& fieldAt(State& s, const TelemetryField& f, uint8_t i) {
+  return reinterpret_cast<int*>(reinterpret_cast<uint8_t*>(&s) + f.offset)[i];
+}
+
+static inline int fieldAt(const State& s, const TelemetryField& f, uint8_t i) {
+  return reinterpret_cast<const int*>(reinterpret_cast<const uint8_t*>(&s) + f.offset)[i];
+}
+
+// =======================================================
+// === 상태
+// =======================================================
+
+static State sent;                      // 마지막으로 호스트에 보낸 값
+static bool sentValid = false;          // false 면 다음 poll 에서 키프레임
+static unsigned long lastSampleMs = 0;
+static unsigned long lastDeltaMs = 0;
+static unsigned long lastKeyframeMs = 0;
+
+void telemetryReset() {
+  sentValid = false;
+}
+
+static bool fieldChanged(const TelemetryField& f, uint8_t i) {
+  int cur = fieldAt(stateSnapshot(), f, i);
+  int old = fieldAt(sent, f, i);
+  int diff = (cur > old) ? (cur - old) : (old - cur);
+  return f.deadband == 0 ? diff != 0 : diff > (int)f.deadband;
+}
+
+/**
+ * @brief 그룹 g 의 유닛 i 에서 바뀐 필드를 한 줄로 보내고 스냅샷 갱신
+ * @param edgesOnly true 면 디지털 에지가 있는 유닛만 (아날로그 변경분은 같이 실어 보냄)
+ * @return 보냈으면 true
+ */
+static bool sendUnitDelta(uint8_t g, uint8_t i, bool edgesOnly, Print& out) {
+  bool any = false, edge = false;
+  for (uint8_t k = 0; k < FIELD_COUNT; k++) {
+    if (FIELDS[k].group != g || !fieldChanged(FIELDS[k], i)) continue;
+    any = true;
+    if (FIELDS[k].deadband == 0) edge = true;
+  }
+  if (!any || (edgesOnly && !edge)) return false;
+
+  const State& state = stateSnapshot();
+  StaticJsonDocument<256> doc;
+  doc["device"] = GROUP_NAMES[g];
+  if (g != TG_DOOR) doc["control"] = i + 1;
+  stampRecord(doc, g);
+  for (uint8_t k = 0; k < FIELD_COUNT; k++) {
+    const TelemetryField& f = FIELDS[k];
+    if (f.group != g || !fieldChanged(f, i)) continue;
+    doc[f.name] = fieldAt(state, f, i);
+    fieldAt(sent, f, i) = fieldAt(state, f, i);
+  }
+  serializeJson(doc, out);
+  out.println();
+  return true;
+}
+
+static bool anyChanged(bool edgesOnly) {
+  for (uint8_t k = 0; k < FIELD_COUNT; k++) {
+    const TelemetryField& f = FIELDS[k];
+    if (edgesOnly && f.deadband != 0) continue;
+    uint8_t n = groupCount(f.group);
+    for (uint8_t i = 0; i < n; i++) {
+      if (fieldChanged(f, i)) return true;
+    }
+  }
+  return false;
+}
+
+static void sendKeyframe() {
+  if (current.protocol == PROTO_BINARY) publishStateBinary();
+  else publishStateJson();
+  sent = stateSnapshot();
+  sentValid = true;
+}
+
+// =======================================================
+// === 주기 처리
+// =======================================================
+
+bool telemetryPoll(unsigned long now) {
+  if (now - lastSampleMs < TELEMETRY_SAMPLE_MS) return false;
+  lastSampleMs = now;
+  readAllSensors();
+
+  if (!sentValid || now - lastKeyframeMs >= TELEMETRY_KEYFRAME_MS) {
+    lastKeyframeMs = now;
+    lastDeltaMs = now;
+    sendKeyframe();
+    return true;
+  }
+
+  bool periodic = (now - lastDeltaMs >= tuning.publishMs);
+  if (periodic) lastDeltaMs = now;
+  if (!anyChanged(!periodic)) return false;
+
+  // 바이너리: 패킷 단위라 필드 delta 대신 "바뀌었을 때만 전체 패킷"
+  if (current.protocol == PROTO_BINARY) {
+    publishStateBinary();
+    sent = stateSnapshot();
+    return true;
+  }
+
+  // 에지는 즉시, 아날로그 변경분은 주기마다. 키프레임과의 순서가 뒤바뀌지
+  // 않도록 둘 다 TxTelemetry 로 보낸다 (delta 모드에선 대기열이 거의 비어 있음)
+  bool wrote = false;
+  for (uint8_t g = 0; g < TG_COUNT; g++) {
+    uint8_t n = groupCount(g);
+    for (uint8_t i = 0; i < n; i++) {
+      if (sendUnitDelta(g, i, !periodic, TxTelemetry)) wrote = true;
+    }
+  }
+  return wrote;
+}
+
+// =======================================================
+// === 구독 (subscribe 모드)
+// =======================================================
+
+static_assert(sizeof(FIELDS) / sizeof(FIELDS[0]) <= 32, "subscription field mask is 32 bits");
+
+struct Subscription {
+  bool active;
+  uint8_t group;
+  uint8_t unitMask;        // bit i = control i+1
+  uint32_t fieldMask;      // bit k = FIELDS[k]
+  uint16_t periodMs;
+  unsigned long dueMs;
+  uint32_t sent;           // 보낸 레코드 수 (list 에 표시)
+};
+
+static Subscription subs[TELEMETRY_MAX_SUBS];
+static_assert(TELEMETRY_MAX_SUBS <= 8, "subscriptionPoll due mask is 8 bits");
+
+static void sendSubscription(Subscription& s) {
+  const State& state = stateSnapshot();
+  uint8_t n = groupCount(s.group);
+  for (uint8_t i = 0; i < n; i++) {
+    if (!(s.unitMask & (1u << i))) continue;
+    StaticJsonDocument<256> doc;
+    doc["device"] = GROUP_NAMES[s.group];
+    if (s.group != TG_DOOR) doc["control"] = i + 1;
+    stampRecord(doc, s.group);
+    for (uint8_t k = 0; k < FIELD_COUNT; k++) {
+      if (s.fieldMask & (1UL << k)) doc[FIELDS[k].name] = fieldAt(state, FIELDS[k], i);
+    }
+    serializeJson(doc, TxTelemetry);
+    TxTelemetry.println();
+    s.sent++;
+  }
+}
+
+bool subscriptionPoll(unsigned long now) {
+  uint8_t readMask = 0;   // 이번 호출에서 읽은 장비 종류
+  uint8_t dueMask = 0;    // 이번 호출에서 보낼 구독
+  for (uint8_t n = 0; n < TELEMETRY_MAX_SUBS; n++) {
+    Subscription& s = subs[n];
+    if (!s.active || (long)(now - s.dueMs) < 0) continue;
+    s.dueMs += s.periodMs;
+    if ((long)(now - s.dueMs) >= 0) s.dueMs = now + s.periodMs;   // 밀린 주기는 몰아서 보내지 않음
+    dueMask |= (uint8_t)(1u << n);
+    if (!(readMask & (1u << s.group))) {
+      readSensors(s.group);
+      readMask |= (uint8_t)(1u << s.group);
+    }
+  }
+  if (!dueMask) return false;
+  snapshotCommit();   // 이번에 읽은 묶음들이 한 epoch
+
+  bool wrote = false;
+  bool binaryDue = false;
+  for (uint8_t n = 0; n < TELEMETRY_MAX_SUBS; n++) {
+    Subscription& s = subs[n];
+    if (!(dueMask & (1u << n))) continue;
+    if (current.protocol == PROTO_BINARY) {
+      binaryDue = true;
+      s.sent++;
+    } else {
+      sendSubscription(s);
+      wrote = true;
+    }
+  }
+  // 바이너리: 패킷이 고정 형식이라 필드 선택 없이 전체 (구독하지 않은 장비는 마지막으로 읽은 값)
+  if (binaryDue) {
+    publishStateBinary();
+    wrote = true;
+  }
+  return wrote;
+}
+
+static int findGroup(const char* name) {
+  for (uint8_t g = 0; g < TG_COUNT; g++) {
+    if (strcmp(name, GROUP_NAMES[g]) == 0) return g;
+  }
+  return -1;
+}
+
+static int findField(uint8_t group, const char* name) {
+  for (uint8_t k = 0; k < FIELD_COUNT; k++) {
+    if (FIELDS[k].group == group && strcmp(FIELDS[k].name, name) == 0) return k;
+  }
+  return -1;
+}
+
+static void replySubscription(uint8_t id) {
+  const Subscription& s = subs[id];
+  StaticJsonDocument<384> doc;
+  doc["device"] = "subscribe";
+  doc["id"] = id + 1;
+  doc["target"] = GROUP_NAMES[s.group];
+  if (s.unitMask != 0xFF && s.group != TG_DOOR) {
+    uint8_t u = 0;
+    while (!(s.unitMask & (1u << u))) u++;
+    doc["control"] = u + 1;
+  }
+  JsonArray fields = doc.createNestedArray("fields");
+  for (uint8_t k = 0; k < FIELD_COUNT; k++) {
+    if (s.fieldMask & (1UL << k)) fields.add(FIELDS[k].name);
+  }
+  doc["rate_ms"] = s.periodMs;
+  doc["sent"] = s.sent;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+static bool addSubscription(JsonVariantConst doc) {
+  int group = findGroup(doc["target"] | "");
+  if (group < 0) { TxEvent.println("subscribe needs target (cup|ramen|powder|cooker|outlet|door)"); return false; }
+  int control = doc["control"] | 0;
+  // door 는 control 무시
+  if (group != TG_DOOR && (control < 0 || control > groupMax((uint8_t)group))) {
+    TxEvent.println("invalid subscribe control num");
+    return false;
+  }
+  long rate = doc["rate_ms"] | 0L;
+  if (rate < TELEMETRY_SUB_MIN_MS || rate > 60000L) { TxEvent.println("subscribe rate_ms range 10~60000"); return false; }
+
+  uint32_t fieldMask = 0;
+  JsonArrayConst names = doc["fields"];
+  if (names.isNull()) {   // 생략 = 그 장비의 모든 필드
+    for (uint8_t k = 0; k < FIELD_COUNT; k++) {
+      if (FIELDS[k].group == group) fieldMask |= 1UL << k;
+    }
+  } else {
+    for (JsonVariantConst v : names) {
+      int k = findField((uint8_t)group, v | "");
+      if (k < 0) { TxEvent.println("unknown subscribe field"); return false; }
+      fieldMask |= 1UL << k;
+    }
+  }
+  if (fieldMask == 0) { TxEvent.println("subscribe needs fields"); return false; }
+  uint8_t unitMask = (control == 0 || group == TG_DOOR) ? 0xFF : (uint8_t)(1u << (control - 1));
+
+  // 같은 장비(종류 + control) 구독은 새 필드/주기로 교체
+  int slot = -1;
+  for (uint8_t n = 0; n < TELEMETRY_MAX_SUBS; n++) {
+    if (subs[n].active && subs[n].group == group && subs[n].unitMask == unitMask) { slot = n; break; }
+    if (!subs[n].active && slot < 0) slot = n;
+  }
+  if (slot < 0) { TxEvent.println("subscription table full"); return false; }
+
+  Subscription& s = subs[slot];
+  s.active = true;
+  s.group = (uint8_t)group;
+  s.unitMask = unitMask;
+  s.fieldMask = fieldMask;
+  s.periodMs = (uint16_t)rate;
+  s.dueMs = millis();   // 바로 한 번 보냄
+  s.sent = 0;
+  replySubscription((uint8_t)slot);
+  return true;
+}
+
+bool handleSubscribeJson(JsonVariantConst doc) {
+  const char* func = doc["function"] | "list";
+
+  if (strcmp(func, "add") == 0) {
+    return addSubscription(doc);
+  } else if (strcmp(func, "remove") == 0) {
+    int id = doc["id"] | 0;
+    if (id < 1 || id > TELEMETRY_MAX_SUBS || !subs[id - 1].active) { TxEvent.println("unknown subscription id"); return false; }
+    subs[id - 1].active = false;
+  } else if (strcmp(func, "clear") == 0) {
+    for (uint8_t n = 0; n < TELEMETRY_MAX_SUBS; n++) subs[n].active = false;
+  } else if (strcmp(func, "list") != 0) {
+    TxEvent.println("unknown subscribe function");
+    return false;
+  }
+
+  uint8_t count = 0;
+  for (uint8_t n = 0; n < TELEMETRY_MAX_SUBS; n++) {
+    if (!subs[n].active) continue;
+    replySubscription(n);
+    count++;
+  }
+  StaticJsonDocument<96> reply;
+  reply["device"] = "subscribe";
+  reply["count"] = count;
+  reply["active"] = current.telemetry == TELEMETRY_SUBSCRIBE;   // subscribe 모드에서만 발행
+  serializeJson(reply, TxEvent);
+  TxEvent.println();
+  return true;
+}
@@ -0,0 +1,52 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// =======================================================
+// === 변경 기반(delta) 텔레메트리 (setting "telemetry":"delta" 로 활성화)
+// === - 마지막으로 보낸 State 스냅샷과 비교해 바뀐 필드만 전송
+// === - 아날로그 값(amp/sonar/loadcell/lift)은 데드밴드를 넘을 때만,
+// ===   tuning.publishMs 주기로 TxTelemetry 에 모아서 보냄
+// === - 디지털 값(stock/door/dispense 등)의 에지는 TELEMETRY_SAMPLE_MS 주기로
+// ===   감시하여 즉시 보냄 (키프레임과 순서 유지를 위해 같은 TxTelemetry 사용)
+// === - TELEMETRY_KEYFRAME_MS 마다 전체 상태(키프레임)를 보내 호스트 재동기화
+// === - JSON 레코드 형식은 전체 보고와 같고 바뀐 필드만 포함한다.
+// ===   바이너리 모드에서는 변경이 있을 때만 StatePacket 전체를 보낸다.
+// ===
+// === 구독 텔레메트리 (setting "telemetry":"subscribe")
+// === - 구독 = 장비 종류 + 장비(control, 0 = 전체) + 필드 목록 + 주기(ms)
+// ===   예) outlet sonar 20ms, cup stock 1000ms
+// === - 주기가 된 구독의 장비 종류만 읽어서(readSensors) 고른 필드만 보냄
+// ===   {"device":"outlet","control":1,"sonar":..}
+// ===   바이너리 모드에서는 주기가 된 구독이 있을 때 StatePacket 전체
+// === - 명령: {"device":"subscribe","function":"add|remove|clear|list",
+// ===         "target":"cup|ramen|powder|cooker|outlet|door","control":N,
+// ===         "fields":["sonar","loadcell"],"rate_ms":20}  / remove: "id"
+// =======================================================
+
+/**
+ * @brief delta 모드 주기 처리 (loop() 에서 매번 호출)
+ * @param now millis()
+ * @return 이번 호출에서 무엇이든 보냈으면 true
+ */
+bool telemetryPoll(unsigned long now);
+
+/**
+ * @brief 다음 telemetryPoll() 에서 키프레임을 보내도록 스냅샷 무효화
+ *        (setting 변경, 모드 전환 시 호출)
+ */
+void telemetryReset();
+
+/**
+ * @brief subscribe 모드 주기 처리 (loop() 에서 매번 호출)
+ * @return 이번 호출에서 무엇이든 보냈으면 true
+ */
+bool subscriptionPoll(unsigned long now);
+
+/** @brief {"device":"subscribe"} 명령 처리 */
+bool handleSubscribeJson(JsonVariantConst doc);
+
+#endif // TELEMETRY_H
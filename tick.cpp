@@ -0,0 +1,63 @@
+#include <Arduino.h>
+#include "tick.h"
+#include "encoder.h"
+#include "protect.h"
+#include "motor.h"
+#include "measure.h"
+
+static volatile uint32_t ticks = 0;
+
+static void fastTick() {
+  ticks = ticks + 1;
+  encoderTick();
+  protectTick();
+  motorTick();
+  measureTick();
+}
+
+uint32_t fastTickCount() {
+  return ticks;
+}
+
+#ifdef ARDUINO_ARCH_SAM
+// TC1 채널0 (TC3): MCK/128 으로 카운트, RC 비교마다 인터럽트
+// TC3~TC5 는 헤더에 TIOA/TIOB 핀이 없어 analogWrite() 가 건드리지 않는다.
+// (TC0, TC6~TC8 은 D2~D5, D10~D13 의 analogWrite 가 재설정하므로 쓰면 안 됨)
+void fastTickBegin() {
+  pmc_set_writeprotect(false);
+  pmc_enable_periph_clk(ID_TC3);
+  TC_Configure(TC1, 0, TC_CMR_WAVE | TC_CMR_WAVSEL_UP_RC | TC_CMR_TCCLKS_TIMER_CLOCK4);
+  TC_SetRC(TC1, 0, VARIANT_MCK / 128 / FAST_TICK_HZ);
+  TC1->TC_CHANNEL[0].TC_IER = TC_IER_CPCS;
+  TC1->TC_CHANNEL[0].TC_IDR = ~TC_IER_CPCS;
+  NVIC_SetPriority(TC3_IRQn, 8);   // 엔코더 핀(PIO) 인터럽트보다 낮게
+  NVIC_EnableIRQ(TC3_IRQn);
+  TC_Start(TC1, 0);
+}
+
+void TC3_Handler() {
+  TC_GetStatus(TC1, 0);
+  fastTick();
+}
+
+void fastTickPoll() {
+}
+
+#else
+static const uint32_t TICK_US = 1000000UL / FAST_TICK_HZ;
+static uint32_t lastTickUs = 0;
+
+void fastTickBegin() {
+  lastTickUs = micros();
+}
+
+void fastTickPoll() {
+  // 타이머 인터럽트 대신 밀린 tick 을 따라잡음 (최대 10 회, 그 이상은 버림)
+  uint32_t nowUs = micros();
+  for (uint8_t n = 0; n < 10 && nowUs - lastTickUs >= TICK_US; n++) {
+    lastTickUs += TICK_US;
+    fastTick();
+  }
+  if (nowUs - lastTickUs >= TICK_US) lastTickUs = nowUs;
+}
+#endif
@@ -0,0 +1,25 @@
+#ifndef TICK_H
+#define TICK_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// =======================================================
+// === 고정 주기 tick (FAST_TICK_HZ)
+// === - SAM: TC1 채널0(TC3) 비교 인터럽트에서 실행 (헤더 핀 없는 채널, config.h 참고)
+// === - 그 외(호스트): fastTickPoll() 이 밀린 tick 을 따라잡아 실행
+// === - tick 에서 하는 일: encoderTick() (속도/정체), protectTick() (과전류),
+// ===   motorTick() (PWM 램프)
+// ===   인터럽트 컨텍스트이므로 TxEvent 출력 금지. 보고는 각 *Poll() 이 loop 에서.
+// =======================================================
+
+/** @brief tick 시작 (setup 에서 1회) */
+void fastTickBegin();
+
+/** @brief 비 SAM 빌드에서 tick 실행 (loop 에서 매번 호출) */
+void fastTickPoll();
+
+/** @brief 시작 후 tick 수 */
+uint32_t fastTickCount();
+
+#endif // TICK_H
@@ -0,0 +1,127 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "timerwheel.h"
+#include "txbuffer.h"
+
+static const uint16_t SLOT_MASK = TIMER_WHEEL_SLOTS - 1;
+
+static TimerLink slots[TIMER_WHEEL_SLOTS];   // 센티널 (빈 슬롯 = 자기 자신을 가리킴)
+static bool wheelReady = false;
+static unsigned long wheelMs = 0;            // 아직 처리하지 않은 가장 이른 ms
+static uint16_t pending = 0;
+
+// 지연 통계
+static uint32_t firedCount = 0;
+static uint32_t lateSumMs = 0;
+static uint32_t lateMaxMs = 0;
+static uint16_t pendingMax = 0;
+
+static void listInit(TimerLink& head) {
+  head.next = &head;
+  head.prev = &head;
+}
+
+static void linkTail(TimerLink& head, TimerLink* n) {
+  n->prev = head.prev;
+  n->next = &head;
+  head.prev->next = n;
+  head.prev = n;
+}
+
+static void unlink(TimerLink* n) {
+  n->prev->next = n->next;
+  n->next->prev = n->prev;
+  n->next = nullptr;
+  n->prev = nullptr;
+}
+
+static void wheelInit() {
+  for (uint16_t i = 0; i < TIMER_WHEEL_SLOTS; i++) listInit(slots[i]);
+  wheelMs = millis();
+  wheelReady = true;
+}
+
+void timerStartAt(Timer& t, unsigned long dueMs, TimerFn fn, uint8_t arg) {
+  if (!wheelReady) wheelInit();
+  if (timerActive(t)) timerCancel(t);
+  t.due = dueMs;
+  t.fn = fn;
+  t.arg = arg;
+  // 이미 지난 시각은 다음에 처리할 슬롯으로 (지연으로 집계됨)
+  unsigned long slotMs = ((long)(dueMs - wheelMs) < 0) ? wheelMs : dueMs;
+  linkTail(slots[slotMs & SLOT_MASK], &t);
+  if (++pending > pendingMax) pendingMax = pending;
+}
+
+void timerStart(Timer& t, unsigned long delayMs, TimerFn fn, uint8_t arg) {
+  timerStartAt(t, millis() + delayMs, fn, arg);
+}
+
+void timerCancel(Timer& t) {
+  if (!timerActive(t)) return;
+  unlink(&t);
+  pending--;
+}
+
+// 슬롯 하나를 떼어낸 뒤 하나씩 꺼내 만료된 것은 실행, 다음 바퀴 것은 되돌림
+// (콜백이 같은 슬롯의 다른 타이머를 취소/재등록해도 안전)
+static void runSlot(uint16_t s, unsigned long now) {
+  TimerLink& head = slots[s];
+  if (head.next == &head) return;
+
+  TimerLink work;
+  work.next = head.next;
+  work.prev = head.prev;
+  work.next->prev = &work;
+  work.prev->next = &work;
+  listInit(head);
+
+  while (work.next != &work) {
+    Timer* t = static_cast<Timer*>(work.next);
+    unlink(t);
+    if ((long)(now - t->due) >= 0) {
+      pending--;
+      uint32_t late = now - t->due;
+      firedCount++;
+      lateSumMs += late;
+      if (late > lateMaxMs) lateMaxMs = late;
+      t->fn(t->arg);
+    } else {
+      linkTail(head, t);
+    }
+  }
+}
+
+void timerPoll(unsigned long now) {
+  if (!wheelReady) wheelInit();
+  if ((long)(now - wheelMs) < 0) return;
+
+  unsigned long from = wheelMs;
+  unsigned long count = now - from + 1;
+  wheelMs = now + 1;   // 콜백에서 등록되는 타이머는 now 이후 슬롯으로
+  if (pending == 0) return;
+  if (count > TIMER_WHEEL_SLOTS) count = TIMER_WHEEL_SLOTS;   // 한 바퀴 이상 밀림: 전 슬롯 1회
+  for (unsigned long i = 0; i < count; i++) {
+    runSlot((from + i) & SLOT_MASK, now);
+  }
+}
+
+void replyTimerStats() {
+  StaticJsonDocument<128> doc;
+  doc["device"] = "stats";
+  doc["stage"] = "wheel";
+  doc["pending"] = pending;
+  doc["pending_max"] = pendingMax;
+  doc["fired"] = firedCount;
+  doc["late_max"] = lateMaxMs;
+  doc["late_avg"] = firedCount ? (float)lateSumMs / firedCount : 0.0f;
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
+
+void timerResetStats() {
+  firedCount = 0;
+  lateSumMs = 0;
+  lateMaxMs = 0;
+  pendingMax = pending;
+}
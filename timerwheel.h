@@ -0,0 +1,48 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <Arduino.h>
+
+// =======================================================
+// === 해시 타이머 휠 (1ms 해상도, loop 컨텍스트)
+// === - 슬롯 = 만료 시각(ms) % TIMER_WHEEL_SLOTS, 슬롯마다 원형 이중 연결 리스트
+// === - timerStart / timerCancel 은 O(1) (Timer 는 호출자가 소유, 동적 할당 없음)
+// === - timerPoll() 은 지난 ms 의 슬롯만 확인 → loop 비용은 장비 수가 아니라
+// ===   만료되는 타이머 수에 비례. 한 바퀴 이상 먼 타이머는 슬롯에 남아 다음 바퀴에 확인
+// === - 콜백은 loop 에서 실행되므로 TxEvent 출력 가능. 콜백 안에서 재등록/취소 가능
+// === - 지연(만료 시각 대비 실제 실행 시각)은 {"device":"stats"} 의 "wheel" 로 보고
+// =======================================================
+
+const uint16_t TIMER_WHEEL_SLOTS = 256;   // 2 의 거듭제곱
+
+typedef void (*TimerFn)(uint8_t arg);
+
+struct TimerLink {
+  TimerLink* next = nullptr;   // nullptr = 등록 안 됨
+  TimerLink* prev = nullptr;
+};
+
+struct Timer : TimerLink {
+  unsigned long due = 0;       // 만료 시각 (millis)
+  TimerFn fn = nullptr;
+  uint8_t arg = 0;             // 장비 번호 등
+};
+
+/** @brief now + delayMs 에 fn(arg) 실행. 이미 등록돼 있으면 다시 등록 */
+void timerStart(Timer& t, unsigned long delayMs, TimerFn fn, uint8_t arg);
+
+/** @brief 절대 시각 dueMs 에 실행 (주기 타이머의 누적 오차 없는 재등록용) */
+void timerStartAt(Timer& t, unsigned long dueMs, TimerFn fn, uint8_t arg);
+
+/** @brief 등록 취소 (등록 안 된 타이머도 허용) */
+void timerCancel(Timer& t);
+
+inline bool timerActive(const Timer& t) { return t.next != nullptr; }
+
+/** @brief 만료된 타이머 실행 (loop 에서 매번) */
+void timerPoll(unsigned long now);
+
+void replyTimerStats();
+void timerResetStats();
+
+#endif // TIMERWHEEL_H
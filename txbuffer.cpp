@@ -0,0 +1,124 @@
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "txbuffer.h"
+#include "config.h"
+#include "binproto.h"
+
+static uint8_t txEventBuf[TX_EVENT_BUFFER_SIZE];
+static uint8_t txTelemetryBuf[TX_TELEMETRY_BUFFER_SIZE];
+
+TxChannel TxEvent(txEventBuf, sizeof(txEventBuf));
+TxChannel TxTelemetry(txTelemetryBuf, sizeof(txTelemetryBuf));
+
+// 현재 송신 중인 레코드의 채널 (레코드 중간에 다른 채널로 바꾸지 않기 위함)
+static TxChannel* txActive = nullptr;
+static uint16_t txFrameRemain = 0;   // 바이너리 프레임의 남은 바이트 (0 = 텍스트 줄)
+
+TxChannel::TxChannel(uint8_t* buf, uint16_t size)
+  : buf_(buf), mask_(size - 1), head_(0), tail_(0), work_(0),
+    overflow_(false), highWater_(0), dropped_(0) {}
+
+size_t TxChannel::write(uint8_t c) {
+  if (!overflow_) {
+    if ((uint16_t)(work_ - tail_) > mask_) {
+      overflow_ = true;
+    } else {
+      buf_[work_ & mask_] = c;
+      work_++;
+    }
+  }
+  if (c == '\n') commitLine();
+  return 1;
+}
+
+size_t TxChannel::write(const uint8_t* buf, size_t n) {
+  for (size_t i = 0; i < n; i++) write(buf[i]);
+  return n;
+}
+
+void TxChannel::commitLine() {
+  if (overflow_) {
+    work_ = head_;   // 줄 전체 폐기
+    overflow_ = false;
+    dropped_++;
+    return;
+  }
+  head_ = work_;
+  uint16_t used = pending();
+  if (used > highWater_) highWater_ = used;
+}
+
+bool TxChannel::writeRecord(const uint8_t* data, uint16_t n) {
+  if ((uint16_t)(work_ - tail_) + (uint32_t)n > (uint32_t)mask_ + 1) {
+    dropped_++;
+    return false;
+  }
+  for (uint16_t i = 0; i < n; i++) {
+    buf_[work_ & mask_] = data[i];
+    work_++;
+  }
+  commitLine();
+  return true;
+}
+
+uint16_t TxChannel::peek(const uint8_t** data) const {
+  uint16_t used = (uint16_t)(head_ - tail_);
+  uint16_t off = tail_ & mask_;
+  uint16_t toEnd = (uint16_t)(mask_ + 1 - off);
+  *data = &buf_[off];
+  return used < toEnd ? used : toEnd;
+}
+
+void TxChannel::consume(uint16_t n) {
+  tail_ = (uint16_t)(tail_ + n);
+}
+
+/**
+ * @brief UART 송신 버퍼의 빈 공간만큼만 채운다 (loop() 에서 매번 호출)
+ */
+void txPump() {
+  int room = Serial.availableForWrite();
+  while (room > 0) {
+    if (txActive == nullptr) {
+      if (TxEvent.pending()) txActive = &TxEvent;
+      else if (TxTelemetry.pending()) txActive = &TxTelemetry;
+      else return;
+      // 레코드 시작: 바이너리 프레임이면 전체 길이를 미리 계산
+      txFrameRemain = (txActive->at(0) == BIN_SYNC) ? (uint16_t)(BIN_OVERHEAD + txActive->at(1)) : 0;
+    }
+    const uint8_t* p;
+    uint16_t n = txActive->peek(&p);
+    if (n == 0) { txActive = nullptr; return; }
+    if (n > (uint16_t)room) n = (uint16_t)room;
+
+    bool endOfRecord;
+    if (txFrameRemain) {
+      if (n > txFrameRemain) n = txFrameRemain;
+      txFrameRemain -= n;
+      endOfRecord = (txFrameRemain == 0);
+    } else {
+      const uint8_t* nl = (const uint8_t*)memchr(p, '\n', n);
+      if (nl) n = (uint16_t)(nl - p + 1);
+      endOfRecord = (nl != nullptr);
+    }
+
+    Serial.write(p, n);
+    txActive->consume(n);
+    room -= n;
+    if (endOfRecord) txActive = nullptr;  // 다음 레코드는 우선순위에 따라 다시 선택
+  }
+}
+
+void replyTxStats() {
+  StaticJsonDocument<192> doc;
+  doc["device"] = "stats";
+  doc["stage"] = "tx";
+  doc["event_pending"] = TxEvent.pending();
+  doc["event_peak"] = TxEvent.highWater();
+  doc["event_drop"] = TxEvent.droppedLines();
+  doc["telemetry_pending"] = TxTelemetry.pending();
+  doc["telemetry_peak"] = TxTelemetry.highWater();
+  doc["telemetry_drop"] = TxTelemetry.droppedLines();
+  serializeJson(doc, TxEvent);
+  TxEvent.println();
+}
@@ -0,0 +1,59 @@
+#ifndef TXBUFFER_H
+#define TXBUFFER_H
+
+#include <Arduino.h>
+
+// =======================================================
+// === 논블로킹 시리얼 송신 버퍼
+// === - 모든 로그/응답/텔레메트리는 Serial 대신 TxEvent/TxTelemetry 로 출력
+// === - 단일 생산자(loop) / 단일 소비자(txPump) 락프리 링버퍼
+// === - 줄('\n') 단위로 커밋되며, 공간이 부족하면 그 줄 전체를 버리고
+// ===   드롭 카운터를 증가 (반쪽짜리 JSON 이 나가지 않음)
+// === - txPump() 는 UART 송신 버퍼의 빈 공간만큼만 써서 절대 블로킹하지 않고,
+// ===   TxEvent(완료/응답)를 TxTelemetry(주기 보고)보다 항상 먼저 보낸다
+// === - 레코드 경계: 텍스트 줄은 '\n', 바이너리 프레임(BIN_SYNC 로 시작)은 LEN
+// =======================================================
+
+class TxChannel : public Print {
+ public:
+  // size 는 2의 거듭제곱 (최대 32768)
+  TxChannel(uint8_t* buf, uint16_t size);
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+
+  // 줄바꿈과 무관하게 data 전체를 한 레코드로 커밋 (바이너리 프레임용)
+  // 공간이 부족하면 통째로 버리고 false
+  bool writeRecord(const uint8_t* data, uint16_t n);
+
+  uint16_t pending() const { return (uint16_t)(head_ - tail_); }
+  uint16_t highWater() const { return highWater_; }
+  uint32_t droppedLines() const { return dropped_; }
+  void resetStats() { highWater_ = pending(); dropped_ = 0; }
+
+  // --- 소비자 측 (txPump) ---
+  uint16_t peek(const uint8_t** data) const;   // 연속된 커밋 바이트
+  uint8_t at(uint16_t offset) const { return buf_[(uint16_t)(tail_ + offset) & mask_]; }
+  void consume(uint16_t n);
+
+ private:
+  void commitLine();
+
+  uint8_t* buf_;
+  const uint16_t mask_;
+  volatile uint16_t head_;   // 커밋된 쓰기 위치 (생산자만 갱신)
+  volatile uint16_t tail_;   // 읽기 위치 (소비자만 갱신)
+  uint16_t work_;            // 작성 중인 줄의 쓰기 위치
+  bool overflow_;
+  uint16_t highWater_;
+  uint32_t dropped_;
+};
+
+extern TxChannel TxEvent;       // 명령 응답, 완료/상태 이벤트 (우선)
+extern TxChannel TxTelemetry;   // 주기적 상태 보고
+
+void txPump();
+void replyTxStats();
+
+#endif // TXBUFFER_H